@@ -0,0 +1,408 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "../src/poly/polygon.hpp"
+#include "../src/poly/edge_grid.hpp"
+#include "../src/poly/incremental_split.hpp"
+#include "../src/poly/split_batch.hpp"
+#include "../src/poly/split_workspace.hpp"
+#include "../src/poly/thread_pool.hpp"
+#include "../src/poly/vertex_array.hpp"
+
+/* Polygon generators */
+
+/**
+ * @brief Regular polygon of radius 1000.
+*/
+Points convex(size_t n) {
+    Points points;
+    for (size_t k = 0; k < n; k++) {
+        double angle{2 * M_PI * k / n};
+        points.push_back(Point{1000 * cos(angle), 1000 * sin(angle)});
+    }
+
+    return points;
+}
+
+/**
+ * @brief Star whose vertices alternate between radius 1000 and 600.
+*/
+Points concave(size_t n) {
+    Points points;
+    for (size_t k = 0; k < n; k++) {
+        double angle{2 * M_PI * k / n};
+        double radius{k % 2 == 0 ? 1000.0 : 600.0};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+
+    return points;
+}
+
+/**
+ * @brief Star whose vertices alternate between radius 1000 and 10, so
+ * its edges are long and cross most of the polygon.
+*/
+Points star(size_t n) {
+    Points points;
+    for (size_t k = 0; k < n; k++) {
+        double angle{2 * M_PI * k / n};
+        double radius{k % 2 == 0 ? 1000.0 : 10.0};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+
+    return points;
+}
+
+/**
+ * @brief Comb of height 100 with n / 4 teeth 5 units wide along the
+ * x axis.
+*/
+Points comb(size_t n) {
+    size_t teeth{std::max<size_t>(n / 4, 1)};
+
+    Points points;
+    points.push_back(Point{0, 0});
+    points.push_back(Point{10.0 * teeth, 0});
+    for (size_t k = teeth; k > 0; k--) {
+        points.push_back(Point{10.0 * k, 100});
+        points.push_back(Point{10.0 * k - 5, 100});
+        points.push_back(Point{10.0 * k - 5, 50});
+        points.push_back(Point{10.0 * k - 10, 50});
+    }
+
+    return points;
+}
+
+/**
+ * @brief Circle of radius 1000 whose radius changes up to 2 units from
+ * a vertex to the next one, like a traced boundary.
+*/
+Points noisy(size_t n) {
+    Points points;
+    for (size_t k = 0; k < n; k++) {
+        double angle{2 * M_PI * k / n};
+        double radius{1000 + 2 * sin(2.4 * k)};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+
+    return points;
+}
+
+/* Benchmarks */
+template <Points (*Shape)(size_t)>
+void BM_CountSquare(benchmark::State &state) {
+    const Polygon poly{Shape(state.range(0))};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(poly.count_square());
+    }
+
+    state.SetComplexityN(poly.size());
+}
+
+template <Points (*Shape)(size_t)>
+void BM_IsPointInside(benchmark::State &state) {
+    const Polygon poly{Shape(state.range(0))};
+    const Point point{poly.find_center()};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(poly.is_point_inside(point));
+    }
+
+    state.SetComplexityN(poly.size());
+}
+
+/**
+ * @brief Classifies a grid of 1024 points over the bounding box of the
+ * polygon.
+*/
+template <Points (*Shape)(size_t)>
+void BM_ClassifyPoints(benchmark::State &state) {
+    const Points vertices{Shape(state.range(0))};
+    const Polygon poly{vertices};
+
+    auto [min_x, max_x] = std::minmax_element(vertices.begin(), vertices.end(),
+                                              [](const Point &a, const Point &b) { return a.x < b.x; });
+    auto [min_y, max_y] = std::minmax_element(vertices.begin(), vertices.end(),
+                                              [](const Point &a, const Point &b) { return a.y < b.y; });
+    Points points;
+    for (int i = 0; i < 32; i++) {
+        for (int j = 0; j < 32; j++) {
+            points.push_back(Point{min_x->x + (max_x->x - min_x->x) * (i + 0.5) / 32,
+                                   min_y->y + (max_y->y - min_y->y) * (j + 0.5) / 32});
+        }
+    }
+    std::vector<PointLocation> locations(points.size());
+
+    for (auto _ : state) {
+        poly.classify_points(points.data(), points.size(), locations.data());
+        benchmark::DoNotOptimize(locations.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+    state.SetComplexityN(poly.size());
+}
+
+template <Points (*Shape)(size_t)>
+void BM_FindDistance(benchmark::State &state) {
+    const Polygon poly{Shape(state.range(0))};
+    const Point point{poly.find_center()};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(poly.find_distance(point));
+    }
+
+    state.SetComplexityN(poly.size());
+}
+
+template <Points (*Shape)(size_t)>
+void BM_CountSquareArray(benchmark::State &state) {
+    const VertexArray array{Shape(state.range(0))};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array.count_square());
+    }
+
+    state.SetComplexityN(array.size());
+}
+
+template <Points (*Shape)(size_t)>
+void BM_FindDistanceArray(benchmark::State &state) {
+    const Polygon poly{Shape(state.range(0))};
+    const VertexArray array{poly};
+    const Point point{poly.find_center()};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array.find_distance(point));
+    }
+
+    state.SetComplexityN(array.size());
+}
+
+/**
+ * @brief Builds the edge grid that every split builds, reporting the
+ * bytes it keeps.
+*/
+template <Points (*Shape)(size_t)>
+void BM_EdgeGrid(benchmark::State &state) {
+    const Points vertices{Shape(state.range(0))};
+    poly_private::EdgeGrid grid;
+
+    for (auto _ : state) {
+        grid.assign(vertices);
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["bytes"] = static_cast<double>(grid.memory());
+    state.SetComplexityN(vertices.size());
+}
+
+template <Points (*Shape)(size_t)>
+void BM_Split(benchmark::State &state) {
+    const Polygon poly{Shape(state.range(0))};
+    const double square{poly.count_square() * 0.3};
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut_line;
+
+    for (auto _ : state) {
+        try {
+            poly.split(square, poly1, poly2, cut_line);
+        } catch (const Polygon::CannotSplitException &) {
+        }
+        benchmark::DoNotOptimize(cut_line);
+    }
+
+    state.SetComplexityN(poly.size());
+}
+
+/**
+ * @brief Same as BM_Split, reusing the memory of the search.
+*/
+template <Points (*Shape)(size_t)>
+void BM_SplitWorkspace(benchmark::State &state) {
+    const Polygon poly{Shape(state.range(0))};
+    const double square{poly.count_square() * 0.3};
+    SplitWorkspace workspace;
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut_line;
+
+    for (auto _ : state) {
+        try {
+            poly.split(square, poly1, poly2, cut_line, workspace);
+        } catch (const Polygon::CannotSplitException &) {
+        }
+        benchmark::DoNotOptimize(cut_line);
+    }
+
+    state.SetComplexityN(poly.size());
+}
+
+/**
+ * @brief Same as BM_Split, searching first in the polygon simplified
+ * within 4 units and 0.01% of its area.
+*/
+template <Points (*Shape)(size_t)>
+void BM_SplitSimplified(benchmark::State &state) {
+    const Polygon poly{Shape(state.range(0))};
+    const double square{poly.count_square() * 0.3};
+    const SimplifyOptions simplify{4, poly.count_square() * 1E-4};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(poly.split_simplified(square, simplify));
+    }
+
+    state.SetComplexityN(poly.size());
+}
+
+/**
+ * @brief Splits the polygon with 32 areas between 1.5% and 48% of it.
+*/
+template <Points (*Shape)(size_t)>
+void BM_SplitMany(benchmark::State &state) {
+    const Polygon poly{Shape(state.range(0))};
+    std::vector<double> squares;
+    for (int k = 1; k <= 32; k++) {
+        squares.push_back(poly.count_square() * k / 66.0);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(poly.split_many(squares));
+    }
+
+    state.SetItemsProcessed(state.iterations() * squares.size());
+    state.SetComplexityN(poly.size());
+}
+
+/**
+ * @brief Splits 4096 stars of 8 to 64 vertices like many small parcels,
+ * on as many threads as the range.
+*/
+void BM_SplitBatch(benchmark::State &state) {
+    std::vector<Polygon> polygons;
+    std::vector<double> squares;
+    for (size_t k = 0; k < 4096; k++) {
+        polygons.push_back(Polygon{concave(8 + 2 * (k % 29))});
+        squares.push_back(polygons.back().count_square() * 0.3);
+    }
+
+    ThreadPool pool{static_cast<size_t>(state.range(0)) - 1};
+    std::vector<SplitResult> results(polygons.size());
+
+    for (auto _ : state) {
+        split_batch(polygons.data(), squares.data(), polygons.size(), results.data(), SplitOptions{&pool});
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * polygons.size());
+}
+
+/**
+ * @brief Splits again after moving a vertex back and forth, like while
+ * it is dragged.
+*/
+template <Points (*Shape)(size_t)>
+void BM_IncrementalSplit(benchmark::State &state) {
+    Polygon poly{Shape(state.range(0))};
+    const double square{poly.count_square() * 0.3};
+    const size_t vertex{poly.size() / 3};
+    IncrementalSplit splitter;
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut_line;
+    int step{0};
+
+    for (auto _ : state) {
+        poly[vertex] = poly[vertex] + Point{step++ % 2 == 0 ? 0.5 : -0.5, 0};
+        try {
+            splitter.split(poly, square, poly1, poly2, cut_line);
+        } catch (const Polygon::CannotSplitException &) {
+        }
+        benchmark::DoNotOptimize(cut_line);
+    }
+
+    state.SetComplexityN(poly.size());
+}
+
+#define POLY_BENCHMARK(function, shape, max) \
+    BENCHMARK_TEMPLATE(function, shape)->RangeMultiplier(4)->Range(4, max)->Complexity()
+
+POLY_BENCHMARK(BM_CountSquare, convex, 100000);
+POLY_BENCHMARK(BM_CountSquare, concave, 100000);
+POLY_BENCHMARK(BM_CountSquare, comb, 100000);
+
+POLY_BENCHMARK(BM_IsPointInside, convex, 100000);
+POLY_BENCHMARK(BM_IsPointInside, concave, 100000);
+POLY_BENCHMARK(BM_IsPointInside, comb, 100000);
+
+POLY_BENCHMARK(BM_ClassifyPoints, convex, 100000);
+POLY_BENCHMARK(BM_ClassifyPoints, concave, 100000);
+POLY_BENCHMARK(BM_ClassifyPoints, comb, 100000);
+
+POLY_BENCHMARK(BM_FindDistance, convex, 100000);
+POLY_BENCHMARK(BM_FindDistance, concave, 100000);
+POLY_BENCHMARK(BM_FindDistance, comb, 100000);
+
+POLY_BENCHMARK(BM_CountSquareArray, convex, 100000);
+POLY_BENCHMARK(BM_CountSquareArray, concave, 100000);
+POLY_BENCHMARK(BM_CountSquareArray, comb, 100000);
+
+POLY_BENCHMARK(BM_FindDistanceArray, convex, 100000);
+POLY_BENCHMARK(BM_FindDistanceArray, concave, 100000);
+POLY_BENCHMARK(BM_FindDistanceArray, comb, 100000);
+
+// The edge pairs grow with the square of the vertices
+POLY_BENCHMARK(BM_EdgeGrid, concave, 65536);
+POLY_BENCHMARK(BM_EdgeGrid, comb, 65536);
+POLY_BENCHMARK(BM_EdgeGrid, star, 65536);
+
+POLY_BENCHMARK(BM_Split, convex, 4096);
+POLY_BENCHMARK(BM_Split, concave, 4096);
+POLY_BENCHMARK(BM_Split, comb, 4096);
+POLY_BENCHMARK(BM_Split, noisy, 4096);
+POLY_BENCHMARK(BM_Split, star, 4096);
+
+POLY_BENCHMARK(BM_SplitWorkspace, convex, 4096);
+POLY_BENCHMARK(BM_SplitWorkspace, concave, 4096);
+POLY_BENCHMARK(BM_SplitWorkspace, comb, 4096);
+
+POLY_BENCHMARK(BM_SplitSimplified, concave, 4096);
+POLY_BENCHMARK(BM_SplitSimplified, comb, 4096);
+POLY_BENCHMARK(BM_SplitSimplified, noisy, 4096);
+
+POLY_BENCHMARK(BM_SplitMany, convex, 1024);
+POLY_BENCHMARK(BM_SplitMany, concave, 1024);
+POLY_BENCHMARK(BM_SplitMany, comb, 1024);
+
+BENCHMARK(BM_SplitBatch)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+// It keeps nine bytes for each edge pair
+POLY_BENCHMARK(BM_IncrementalSplit, convex, 1024);
+POLY_BENCHMARK(BM_IncrementalSplit, concave, 1024);
+POLY_BENCHMARK(BM_IncrementalSplit, comb, 1024);
+
+BENCHMARK_MAIN();
@@ -2,15 +2,23 @@ QT += core gui widgets
 
 TARGET = poly-split
 TEMPLATE = app
+CONFIG += c++17
 
 SOURCES += \
     main.cpp \
-    ../src/poly/point.cpp \
-    ../src/poly/vector.cpp \
-    ../src/poly/line.cpp \
-    ../src/poly/segment.cpp \
     ../src/poly/polygon.cpp \
+    ../src/poly/polygon_with_holes.cpp \
+    ../src/poly/dataset.cpp \
+    ../src/poly/edge_grid.cpp \
+    ../src/poly/incremental_split.cpp \
+    ../src/poly/simplify.cpp \
+    ../src/poly/split_batch.cpp \
+    ../src/poly/split_cache.cpp \
+    ../src/poly/split_trace.cpp \
+    ../src/poly/thread_pool.cpp \
+    ../src/poly/vertex_array.cpp \
     renderarea.cpp \
+    splitworker.cpp \
     mainwindow.cpp
 
 HEADERS += \
@@ -18,7 +26,21 @@ HEADERS += \
         ../src/poly/vector.hpp \
         ../src/poly/line.hpp \
         ../src/poly/polygon.hpp \
+        ../src/poly/polygon_with_holes.hpp \
+        ../src/poly/dataset.hpp \
+        ../src/poly/edge_grid.hpp \
+        ../src/poly/incremental_split.hpp \
+        ../src/poly/split_batch.hpp \
+        ../src/poly/split_cache.hpp \
+        ../src/poly/split_stats.hpp \
+        ../src/poly/split_trace.hpp \
+        ../src/poly/split_workspace.hpp \
+        ../src/poly/thread_pool.hpp \
+        ../src/poly/predicates.hpp \
+        ../src/poly/simd.hpp \
+        ../src/poly/vertex_array.hpp \
         renderarea.h \
+        splitworker.h \
         mainwindow.h
 
 FORMS += mainwindow.ui
@@ -14,6 +14,12 @@
 std::vector<Polygon> polygons;
 std::vector<QColor> polygons_colors;
 
+// Latest split asked to the worker, and the latest one received
+Polygon requestedPolygon;
+double requestedSquare = -1;
+quint64 requestedGeneration = 0;
+SplitPreview preview;
+
 double squareToCut;
 int selectedPolygon;
 
@@ -70,9 +76,34 @@ RenderArea::RenderArea(QWidget *parent)
     polygons_colors.push_back(Qt::gray);
     polygons_colors.push_back(Qt::darkGray);
 
+    connect(&worker, &SplitWorker::finished, this, &RenderArea::splitFinished, Qt::QueuedConnection);
+
     initPolygons();
 }
 
+void RenderArea::requestSplit()
+{
+    const Polygon &selected = polygons[selectedPolygon];
+    if(squareToCut == requestedSquare && selected.get_vertices() == requestedPolygon.get_vertices())
+    {
+        return;
+    }
+
+    requestedPolygon = selected;
+    requestedSquare = squareToCut;
+    requestedGeneration = worker.request(selected, squareToCut);
+}
+
+void RenderArea::splitFinished(const SplitPreview &result)
+{
+    // The cut of the latest request replaces the one on screen
+    if(result.generation > preview.generation)
+    {
+        preview = result;
+        update();
+    }
+}
+
 void RenderArea::paintEvent(QPaintEvent * /* event */)
 {
     QPainter painter(this);
@@ -117,15 +148,15 @@ void RenderArea::paintEvent(QPaintEvent * /* event */)
         }
     }
 
-    Polygon poly1, poly2;
-    Segment cut;
-    try {
-        polygons[selectedPolygon].split(squareToCut, poly1, poly2, cut);
+    // The split runs on the worker, and its cut is only drawn once it
+    // belongs to the polygon and area on screen
+    requestSplit();
+    if(preview.exists && preview.generation == requestedGeneration)
+    {
+        const Segment &cut = preview.cut;
         painter.setPen(QPen(Qt::black, 1.5));
         //painter.setPen(QPen(Qt::white, 1.5));
         painter.drawLine(QPointF(cut.get_start().x, cut.get_start().y), QPointF(cut.get_end().x, cut.get_end().y));
-    } catch (const Polygon::CannotSplitException &) {
-
     }
 
     if(showInfo)
@@ -167,22 +198,32 @@ void RenderArea::keyPressEvent(QKeyEvent *event)
     }
     if(event->key() == Qt::Key_C)
     {
-        Polygon poly1, poly2;
-        Segment cut;
-        try{
-            polygons[selectedPolygon].split(squareToCut, poly1, poly2, cut);
+        // The cut on screen is used when it belongs to the current
+        // polygon, otherwise the polygon is split here
+        requestSplit();
+        SplitResult result;
+        if(preview.generation == requestedGeneration)
+        {
+            result.exists = preview.exists;
+            result.poly1 = preview.poly1;
+            result.poly2 = preview.poly2;
+        }
+        else
+        {
+            result = polygons[selectedPolygon].try_split(squareToCut);
+        }
 
-            polygons[selectedPolygon] = poly1;
-            polygons.push_back(poly2);
+        if(result.exists)
+        {
+            polygons[selectedPolygon] = result.poly1;
+            polygons.push_back(result.poly2);
 
-            if(poly1.count_square() < poly2.count_square())
+            if(result.poly1.count_square() < result.poly2.count_square())
             {
                 selectedPolygon = polygons.size() - 1;
             }
 
             repaint();
-        } catch (const Polygon::CannotSplitException &) {
-
         }
     }
     if(event->key() == Qt::Key_P)
@@ -284,7 +325,9 @@ void RenderArea::mouseMoveEvent(QMouseEvent *event)
     mouse_x = event->x();
     mouse_y = event->y();
     mouse = Point((event->x() - offset_x) / scale, (event->y() - offset_y) / scale);
-    repaint();
+
+    // The moves between two frames are painted once
+    update();
 }
 
 void RenderArea::mouseReleaseEvent(QMouseEvent *event)
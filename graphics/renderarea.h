@@ -1,6 +1,8 @@
 #ifndef RENDERAREA_H
 #define RENDERAREA_H
 
+#include "splitworker.h"
+
 #include <QWidget>
 
 class RenderArea : public QWidget
@@ -21,8 +23,19 @@ protected:
 
     void wheelEvent(QWheelEvent *event) Q_DECL_OVERRIDE;
 
+private slots:
+    void splitFinished(const SplitPreview &result);
+
 private:
     void initPolygons(void);
+
+    /**
+     * @brief Asks the worker for the split of the selected polygon if it
+     * or the area changed since the last request.
+    */
+    void requestSplit(void);
+
+    SplitWorker worker;
 };
 
 #endif // RENDERAREA_H
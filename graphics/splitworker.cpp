@@ -0,0 +1,73 @@
+#include "splitworker.h"
+
+#include <QMutexLocker>
+
+SplitWorker::SplitWorker()
+{
+    qRegisterMetaType<SplitPreview>("SplitPreview");
+
+    moveToThread(&thread);
+    thread.start();
+}
+
+SplitWorker::~SplitWorker()
+{
+    thread.quit();
+    thread.wait();
+}
+
+quint64 SplitWorker::request(const Polygon &polygon, double square)
+{
+    QMutexLocker lock(&mutex);
+
+    generation++;
+    pending = true;
+    pendingPolygon = polygon;
+    pendingSquare = square;
+
+    // One queued call serves all the requests made until it runs
+    if(!scheduled)
+    {
+        scheduled = true;
+        QMetaObject::invokeMethod(this, "process", Qt::QueuedConnection);
+    }
+
+    return generation;
+}
+
+void SplitWorker::process()
+{
+    for(;;)
+    {
+        SplitPreview preview;
+        Polygon polygon;
+        double square;
+        {
+            QMutexLocker lock(&mutex);
+            if(!pending)
+            {
+                scheduled = false;
+                return;
+            }
+
+            pending = false;
+            preview.generation = generation;
+            polygon = pendingPolygon;
+            square = pendingSquare;
+        }
+
+        // Repeated requests come from the cache, and a dragged vertex
+        // only searches again the edge pairs it changes
+        try {
+            cache.split_with(polygon, square, preview.poly1, preview.poly2, preview.cut,
+                             [&](Polygon &p1, Polygon &p2, Segment &c) {
+                                 splitter.split(polygon, square, p1, p2, c);
+                             });
+            preview.exists = true;
+        } catch (const Polygon::CannotSplitException &) {
+
+        }
+
+        emit finished(preview);
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef SPLITWORKER_H
+#define SPLITWORKER_H
+
+#include <QMetaType>
+#include <QMutex>
+#include <QObject>
+#include <QThread>
+
+#include <../src/poly/polygon.hpp>
+#include <../src/poly/incremental_split.hpp>
+#include <../src/poly/split_cache.hpp>
+
+/**
+ * @brief The split of one request of SplitWorker.
+*/
+struct SplitPreview
+{
+    // Number of the request, they grow with every request
+    quint64 generation = 0;
+    bool exists = false;
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+};
+
+Q_DECLARE_METATYPE(SplitPreview)
+
+/**
+ * @brief Splits polygons on its own thread. Only the latest request is
+ * kept while a split runs, so the older ones are dropped instead of
+ * queued, and every result is delivered by the finished signal.
+*/
+class SplitWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    SplitWorker();
+    ~SplitWorker();
+
+    /**
+     * @brief Asks for the split of the polygon, replacing the request
+     * not started yet. Returns the generation of the request.
+    */
+    quint64 request(const Polygon &polygon, double square);
+
+signals:
+    void finished(const SplitPreview &preview);
+
+private slots:
+    void process();
+
+private:
+    QThread thread;
+
+    // Latest request, guarded by the mutex
+    QMutex mutex;
+    bool scheduled = false;
+    bool pending = false;
+    quint64 generation = 0;
+    Polygon pendingPolygon;
+    double pendingSquare = 0;
+
+    // Only used by the thread of the worker
+    IncrementalSplit splitter;
+    SplitCache cache;
+};
+
+#endif // SPLITWORKER_H
@@ -0,0 +1,236 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "split_io.hpp"
+#include "../poly/split_trace.hpp"
+#include "../poly/thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+const char *usage{
+    "Usage: poly_split_cli [options] [input [output]]\n"
+    "\n"
+    "Splits every polygon of the input, one per line, in the format\n"
+    "  area x1 y1 x2 y2 ...\n"
+    "or\n"
+    "  area POLYGON ((x1 y1, x2 y2, ...))\n"
+    "and writes a line for each one, in the same order and format:\n"
+    "  line ok cut | poly1 | poly2\n"
+    "  line error message\n"
+    "poly2 has the area. Blank lines and lines starting with '#' are skipped.\n"
+    "The input and the output are the standard ones when missing or '-'.\n"
+    "\n"
+    "Options:\n"
+    "  -j N          Worker threads, all the cores by default\n"
+    "  -b N          Polygons read and split together, 1024 by default\n"
+    "  --latency     Append the time of each split, in microseconds\n"
+    "  --trace FILE  Write a Chrome trace of the splits, when the library is\n"
+    "                built with POLY_SPLIT_TRACE\n"
+    "  -h, --help    Show this text\n"};
+
+struct Options {
+    size_t threads{std::max(1U, std::thread::hardware_concurrency())};
+    size_t batch{1024};
+    bool latency{false};
+    std::string trace;
+    std::string input{"-"};
+    std::string output{"-"};
+};
+
+bool parse_count(const char *text, size_t &value) {
+    char *end;
+    long long parsed{std::strtoll(text, &end, 10)};
+    if (*text == '\0' || *end != '\0' || parsed < 1)
+        return false;
+
+    value = static_cast<size_t>(parsed);
+    return true;
+}
+
+bool parse_options(int argc, char **argv, Options &options) {
+    std::vector<std::string> files;
+    for (int k = 1; k < argc; k++) {
+        const char *arg{argv[k]};
+        if (std::strcmp(arg, "-j") == 0 && k + 1 < argc) {
+            if (!parse_count(argv[++k], options.threads))
+                return false;
+        } else if (std::strcmp(arg, "-b") == 0 && k + 1 < argc) {
+            if (!parse_count(argv[++k], options.batch))
+                return false;
+        } else if (std::strcmp(arg, "--latency") == 0) {
+            options.latency = true;
+        } else if (std::strcmp(arg, "--trace") == 0 && k + 1 < argc) {
+            options.trace = argv[++k];
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            return false;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    if (files.size() > 2)
+        return false;
+    if (files.size() > 0)
+        options.input = files[0];
+    if (files.size() > 1)
+        options.output = files[1];
+
+    return true;
+}
+
+double percentile(const std::vector<double> &sorted, double p) {
+    if (sorted.empty())
+        return 0;
+
+    size_t k{static_cast<size_t>(p * (sorted.size() - 1) + 0.5)};
+    return sorted[k];
+}
+};
+
+int main(int argc, char **argv) {
+    Options options;
+    for (int k = 1; k < argc; k++) {
+        if (std::strcmp(argv[k], "-h") == 0 || std::strcmp(argv[k], "--help") == 0) {
+            std::cout << usage;
+            return EXIT_SUCCESS;
+        }
+    }
+
+    if (!parse_options(argc, argv, options)) {
+        std::cerr << usage;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input_file;
+    if (options.input != "-") {
+        input_file.open(options.input);
+        if (!input_file) {
+            std::cerr << "Cannot open " << options.input << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::istream &input{options.input != "-" ? input_file : std::cin};
+
+    std::ofstream output_file;
+    if (options.output != "-") {
+        output_file.open(options.output);
+        if (!output_file) {
+            std::cerr << "Cannot open " << options.output << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream &output{options.output != "-" ? output_file : std::cout};
+
+    std::ofstream trace_file;
+    if (!options.trace.empty()) {
+        trace_file.open(options.trace);
+        if (!trace_file) {
+            std::cerr << "Cannot open " << options.trace << "\n";
+            return EXIT_FAILURE;
+        }
+        SplitTrace::start();
+    }
+
+    // The calling thread is one of the workers
+    ThreadPool pool{options.threads - 1};
+
+    std::vector<SplitJob> jobs;
+    std::vector<SplitResult> results;
+    std::vector<std::string> errors;
+    std::vector<double> latencies;
+    std::vector<double> all_latencies;
+    size_t jobs_count{0};
+    size_t failed{0};
+
+    auto start{std::chrono::steady_clock::now()};
+    std::string text;
+    size_t line{0};
+    bool more{true};
+
+    // The polygons are read in batches, so the memory does not grow with
+    // the input and the output follows it
+    while (more) {
+        jobs.clear();
+        while (jobs.size() < options.batch && (more = static_cast<bool>(std::getline(input, text)))) {
+            SplitJob job;
+            job.line = ++line;
+            if (parse_split_job(text, job)) {
+                jobs.push_back(std::move(job));
+            }
+        }
+
+        jobs_count += jobs.size();
+        results.assign(jobs.size(), SplitResult{});
+        errors.assign(jobs.size(), std::string{});
+        latencies.assign(jobs.size(), 0);
+
+        pool.run(jobs.size(), [&](size_t k) {
+            if (!jobs[k].error.empty()) {
+                errors[k] = jobs[k].error;
+                return;
+            }
+
+            auto begin{std::chrono::steady_clock::now()};
+            results[k] = jobs[k].polygon.try_split(jobs[k].square);
+            errors[k] = split_status_message(results[k].status);
+            latencies[k] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+        });
+
+        for (size_t k = 0; k < jobs.size(); k++) {
+            output << format_split_result(jobs[k], results[k], errors[k]);
+            if (options.latency) {
+                output << " " << latencies[k];
+            }
+            output << "\n";
+
+            failed += results[k].exists ? 0 : 1;
+            if (jobs[k].error.empty()) {
+                all_latencies.push_back(latencies[k]);
+            }
+        }
+    }
+    output.flush();
+
+    if (trace_file.is_open()) {
+        SplitTrace::stop();
+        SplitTrace::write(trace_file);
+    }
+
+    double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+    std::sort(all_latencies.begin(), all_latencies.end());
+
+    std::fprintf(stderr, "%zu polygons, %zu failed, %zu threads, %.3f s, %.1f polygons/s\n",
+                 jobs_count, failed, options.threads, seconds, seconds > 0 ? jobs_count / seconds : 0.0);
+    std::fprintf(stderr, "latency us: p50 %.1f, p90 %.1f, p99 %.1f, max %.1f\n",
+                 percentile(all_latencies, 0.5), percentile(all_latencies, 0.9),
+                 percentile(all_latencies, 0.99), all_latencies.empty() ? 0.0 : all_latencies.back());
+
+    return output ? EXIT_SUCCESS : EXIT_FAILURE;
+}
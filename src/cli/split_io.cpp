@@ -0,0 +1,203 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "split_io.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+void skip_spaces(const char *&p) {
+    while (std::isspace(static_cast<unsigned char>(*p)))
+        p++;
+}
+
+bool read_number(const char *&p, double &value) {
+    skip_spaces(p);
+    char *end;
+    value = std::strtod(p, &end);
+    if (end == p)
+        return false;
+
+    p = end;
+    return true;
+}
+
+/**
+ * @brief Consumes the character c, after the spaces before it.
+*/
+bool read_char(const char *&p, char c) {
+    skip_spaces(p);
+    if (*p != c)
+        return false;
+
+    p++;
+    return true;
+}
+
+/**
+ * @brief Consumes the word, in any case, after the spaces before it.
+*/
+bool read_word(const char *&p, const char *word) {
+    skip_spaces(p);
+    size_t length{std::strlen(word)};
+    for (size_t k = 0; k < length; k++) {
+        if (std::toupper(static_cast<unsigned char>(p[k])) != word[k])
+            return false;
+    }
+
+    p += length;
+    return true;
+}
+
+/**
+ * @brief Reads "((x y, x y, ...))". The closing vertex of WKT, equal to
+ * the first one, is dropped.
+*/
+std::string read_wkt_polygon(const char *&p, Points &points) {
+    if (read_word(p, "EMPTY"))
+        return "";
+
+    if (!read_char(p, '(') || !read_char(p, '('))
+        return "Expected '((' after POLYGON";
+
+    do {
+        Point point;
+        if (!read_number(p, point.x) || !read_number(p, point.y))
+            return "Expected a coordinate pair";
+        points.push_back(point);
+    } while (read_char(p, ','));
+
+    if (!read_char(p, ')'))
+        return "Expected ')' after the coordinates";
+
+    if (read_char(p, ','))
+        return "Polygons with holes are not supported";
+
+    if (!read_char(p, ')'))
+        return "Expected ')' after the ring";
+
+    if (points.size() > 1 && points.front() == points.back()) {
+        points.pop_back();
+    }
+
+    return "";
+}
+
+void write_number(std::string &out, double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    out += buffer;
+}
+
+void write_points(std::string &out, const Points &points, SplitFormat format, bool close) {
+    for (size_t k = 0; k < points.size() + (close && !points.empty() ? 1 : 0); k++) {
+        const Point &p{points[k < points.size() ? k : 0]};
+        if (k > 0)
+            out += format == SplitFormat::Wkt ? ", " : " ";
+        write_number(out, p.x);
+        out += ' ';
+        write_number(out, p.y);
+    }
+}
+};
+
+bool parse_split_job(const std::string &text, SplitJob &job) {
+    const char *p{text.c_str()};
+    skip_spaces(p);
+    if (*p == '\0' || *p == '#')
+        return false;
+
+    Points points;
+    if (!read_number(p, job.square)) {
+        job.error = "Expected the area";
+        return true;
+    }
+
+    skip_spaces(p);
+    if (std::isalpha(static_cast<unsigned char>(*p))) {
+        job.format = SplitFormat::Wkt;
+        if (!read_word(p, "POLYGON")) {
+            job.error = "Only POLYGON geometries are supported";
+            return true;
+        }
+
+        job.error = read_wkt_polygon(p, points);
+        if (!job.error.empty())
+            return true;
+    } else {
+        job.format = SplitFormat::Lines;
+        double x;
+        double y;
+        while (read_number(p, x)) {
+            if (!read_number(p, y)) {
+                job.error = "Odd number of coordinates";
+                return true;
+            }
+            points.push_back(Point{x, y});
+        }
+    }
+
+    skip_spaces(p);
+    if (*p != '\0') {
+        job.error = std::string{"Unexpected text: "} + p;
+        return true;
+    }
+
+    if (points.size() < 3) {
+        job.error = "The polygon has not enough vertices";
+        return true;
+    }
+
+    job.polygon = Polygon{points};
+    return true;
+}
+
+std::string format_split_result(const SplitJob &job, const SplitResult &result, const std::string &error) {
+    std::string out{std::to_string(job.line)};
+
+    if (!result.exists) {
+        out += " error ";
+        out += error;
+        return out;
+    }
+
+    const Points cut{result.cut_line.get_start(), result.cut_line.get_end()};
+    if (job.format == SplitFormat::Wkt) {
+        out += " ok LINESTRING (";
+        write_points(out, cut, job.format, false);
+        out += ") | POLYGON ((";
+        write_points(out, result.poly1.get_vertices(), job.format, true);
+        out += ")) | POLYGON ((";
+        write_points(out, result.poly2.get_vertices(), job.format, true);
+        out += "))";
+    } else {
+        out += " ok ";
+        write_points(out, cut, job.format, false);
+        out += " | ";
+        write_points(out, result.poly1.get_vertices(), job.format, false);
+        out += " | ";
+        write_points(out, result.poly2.get_vertices(), job.format, false);
+    }
+
+    return out;
+}
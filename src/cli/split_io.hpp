@@ -0,0 +1,63 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "../poly/polygon.hpp"
+#include <string>
+
+/**
+ * @brief How a polygon is written in the input of poly_split_cli, and so
+ * how its result is written.
+*/
+enum class SplitFormat {
+    // The area and then the coordinates: "area x1 y1 x2 y2 ..."
+    Lines,
+    // The area and then a WKT polygon: "area POLYGON ((x1 y1, ...))"
+    Wkt
+};
+
+/**
+ * @brief A polygon and the area to cut from it, read from a line of the
+ * input.
+*/
+struct SplitJob {
+    // Number of the line in the input, from 1
+    size_t line{0};
+    SplitFormat format{SplitFormat::Lines};
+    double square{0};
+    Polygon polygon;
+    // Why the line could not be read, empty if it could
+    std::string error;
+};
+
+/**
+ * @brief Reads a line of the input. It returns false if the line has
+ * nothing to split, because it is blank or a comment starting with '#'.
+ * Malformed lines return true with job.error set.
+*/
+bool parse_split_job(const std::string &text, SplitJob &job);
+
+/**
+ * @brief Writes the result of a job in its format, without the line end.
+ * The successful ones are "line ok cut | poly1 | poly2", and the others
+ * "line error message".
+*/
+std::string format_split_result(const SplitJob &job, const SplitResult &result, const std::string &error);
@@ -0,0 +1,209 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "dataset.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define POLY_SPLIT_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const char magic[8]{'P', 'O', 'L', 'Y', 'D', 'S', 'E', 'T'};
+const uint32_t version{1};
+const uint32_t byte_order{0x01020304};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t polygon_count;
+    uint64_t vertex_count;
+    // Where the vertices and the offsets table start
+    uint64_t vertices_offset;
+    uint64_t offsets_offset;
+};
+
+static_assert(sizeof(Header) == 48, "The header is 48 bytes long");
+static_assert(std::is_standard_layout_v<Point> && sizeof(Point) == 2 * sizeof(double),
+              "The vertices are read in place as x and y pairs");
+};
+
+Dataset::InvalidFileException::InvalidFileException() {}
+
+Dataset::InvalidFileException::InvalidFileException(const std::string &message) {
+    this->message = message;
+}
+
+Dataset::InvalidFileException::InvalidFileException(const char *message) {
+    this->message = message;
+}
+
+const char *Dataset::InvalidFileException::what() const noexcept {
+    return message.c_str();
+}
+
+Dataset::Dataset(const std::string &path) {
+#ifdef POLY_SPLIT_MMAP
+    int fd{::open(path.c_str(), O_RDONLY)};
+    if (fd < 0)
+        throw InvalidFileException{"Can not open " + path + ": " + std::strerror(errno)};
+
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw InvalidFileException{"Can not read " + path + ": " + std::strerror(errno)};
+    }
+
+    byte_count = static_cast<size_t>(status.st_size);
+    if (byte_count > 0) {
+        void *address{mmap(nullptr, byte_count, PROT_READ, MAP_PRIVATE, fd, 0)};
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            throw InvalidFileException{"Can not map " + path + ": " + std::strerror(errno)};
+        }
+        bytes = static_cast<const unsigned char *>(address);
+    }
+    // The mapping stays valid after the file is closed
+    ::close(fd);
+#else
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+    if (!file)
+        throw InvalidFileException{"Can not open " + path};
+
+    byte_count = static_cast<size_t>(file.tellg());
+    buffer.resize((byte_count + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(byte_count)))
+        throw InvalidFileException{"Can not read " + path};
+    bytes = reinterpret_cast<const unsigned char *>(buffer.data());
+#endif
+
+    try {
+        check();
+    } catch (const InvalidFileException &e) {
+        unmap();
+        throw InvalidFileException{path + ": " + e.what()};
+    }
+}
+
+Dataset::~Dataset() {
+    unmap();
+}
+
+void Dataset::unmap(void) {
+#ifdef POLY_SPLIT_MMAP
+    if (bytes != nullptr) {
+        munmap(const_cast<unsigned char *>(bytes), byte_count);
+    }
+#endif
+    bytes = nullptr;
+}
+
+void Dataset::check(void) {
+    Header header;
+    if (byte_count < sizeof(header))
+        throw InvalidFileException{"The file is too short"};
+
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+        throw InvalidFileException{"The file is not a dataset"};
+    if (header.byte_order != byte_order)
+        throw InvalidFileException{"The dataset was written with another byte order"};
+    if (header.version != version)
+        throw InvalidFileException{"The dataset version is not supported"};
+
+    // Both tables must be aligned and fit in the file
+    uint64_t size{byte_count};
+    if (header.vertices_offset % sizeof(double) != 0 || header.vertices_offset > size ||
+        header.vertex_count > (size - header.vertices_offset) / sizeof(Point))
+        throw InvalidFileException{"The vertices do not fit in the file"};
+    if (header.offsets_offset % sizeof(uint64_t) != 0 || header.offsets_offset > size ||
+        header.polygon_count >= (size - header.offsets_offset) / sizeof(uint64_t))
+        throw InvalidFileException{"The offsets table does not fit in the file"};
+
+    vertices = reinterpret_cast<const Point *>(bytes + header.vertices_offset);
+    offsets = reinterpret_cast<const uint64_t *>(bytes + header.offsets_offset);
+    polygon_count = static_cast<size_t>(header.polygon_count);
+
+    // Every polygon must lie inside the vertices, so that the views can
+    // be made without checking them
+    if (offsets[0] != 0 || offsets[polygon_count] != header.vertex_count)
+        throw InvalidFileException{"The offsets table does not cover the vertices"};
+    for (size_t k = 0; k < polygon_count; k++) {
+        if (offsets[k + 1] < offsets[k])
+            throw InvalidFileException{"The offsets table is not sorted"};
+    }
+}
+
+DatasetWriter::DatasetWriter(const std::string &path) : file{path, std::ios::binary | std::ios::trunc} {
+    if (!file)
+        throw Dataset::InvalidFileException{"Can not create " + path};
+
+    // The header is written again when the file is closed
+    Header header{};
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+DatasetWriter::~DatasetWriter() {
+    try {
+        close();
+    } catch (const Dataset::InvalidFileException &) {
+    }
+}
+
+void DatasetWriter::push_back(const PolygonView &polygon) {
+    if (!open)
+        throw Dataset::InvalidFileException{"The dataset is closed"};
+
+    file.write(reinterpret_cast<const char *>(polygon.data()),
+               static_cast<std::streamsize>(polygon.size() * sizeof(Point)));
+    offsets.push_back(offsets.back() + polygon.size());
+}
+
+void DatasetWriter::close(void) {
+    if (!open)
+        return;
+    open = false;
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.byte_order = byte_order;
+    header.polygon_count = offsets.size() - 1;
+    header.vertex_count = offsets.back();
+    header.vertices_offset = sizeof(Header);
+    header.offsets_offset = sizeof(Header) + header.vertex_count * sizeof(Point);
+
+    file.write(reinterpret_cast<const char *>(offsets.data()),
+               static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.close();
+    if (!file)
+        throw Dataset::InvalidFileException{"Can not write the dataset"};
+}
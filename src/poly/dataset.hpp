@@ -0,0 +1,147 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "polygon.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Polygons stored in the binary dataset format, mapped in memory
+ * so that they are used without parsing nor copying them. The file is
+ * not loaded at once: the pages are read when the polygons are used.
+ *
+ * The file starts with a 48 byte header, followed by the x and y of the
+ * vertices of all the polygons as doubles, and ends with a table with the
+ * index of the first vertex of every polygon and the number of vertices.
+ * The numbers keep the byte order of the machine that wrote them, which
+ * the header records. DatasetWriter writes them.
+*/
+class Dataset {
+    private:
+        const unsigned char *bytes{nullptr};
+        size_t byte_count{0};
+        // The file read into memory where it can not be mapped
+        std::vector<uint64_t> buffer;
+
+        const Point *vertices{nullptr};
+        const uint64_t *offsets{nullptr};
+        size_t polygon_count{0};
+
+        void check(void);
+        void unmap(void);
+
+    public:
+        class InvalidFileException : public std::exception {
+            std::string message{"The dataset file is not valid"};
+            public:
+                InvalidFileException();
+                InvalidFileException(const std::string &message);
+                InvalidFileException(const char *message);
+                const char *what() const noexcept override;
+        };
+
+        /**
+         * @brief Maps the file and checks its header and offsets table.
+         *
+         * @throws
+         * Dataset::InvalidFileException: if the file can not be read or
+         * it is not a valid dataset.
+        */
+        explicit Dataset(const std::string &path);
+        Dataset(const Dataset &) = delete;
+        Dataset &operator=(const Dataset &) = delete;
+        ~Dataset();
+
+        /**
+         * @brief Returns the number of polygons.
+        */
+        size_t size(void) const {
+            return polygon_count;
+        }
+
+        /**
+         * @brief Returns the number of vertices of all the polygons.
+        */
+        size_t vertex_count(void) const {
+            return offsets[polygon_count];
+        }
+
+        /**
+         * @brief Returns the polygon at index. The view is valid while the
+         * dataset exists.
+        */
+        PolygonView operator[](size_t index) const {
+            return PolygonView{vertices + offsets[index], offsets[index + 1] - offsets[index]};
+        }
+};
+
+/**
+ * @brief Writes polygons in the format of Dataset. The vertices are
+ * written as they are added, and the offsets table and the header when
+ * the writer is closed. The two parts of a split are added as two
+ * polygons.
+*/
+class DatasetWriter {
+    private:
+        std::ofstream file;
+        std::vector<uint64_t> offsets{0};
+        bool open{true};
+
+    public:
+        /**
+         * @throws
+         * Dataset::InvalidFileException: if the file can not be created.
+        */
+        explicit DatasetWriter(const std::string &path);
+        DatasetWriter(const DatasetWriter &) = delete;
+        DatasetWriter &operator=(const DatasetWriter &) = delete;
+
+        /**
+         * @brief Closes the file if it was not closed. The errors are
+         * ignored, close reports them.
+        */
+        ~DatasetWriter();
+
+        void push_back(const PolygonView &polygon);
+
+        void push_back(const Polygon &polygon) {
+            push_back(polygon.view());
+        }
+
+        /**
+         * @brief Returns the number of polygons added.
+        */
+        size_t size(void) const {
+            return offsets.size() - 1;
+        }
+
+        /**
+         * @brief Writes the offsets table and the header. Nothing can be
+         * added afterwards.
+         *
+         * @throws
+         * Dataset::InvalidFileException: if the file can not be written.
+        */
+        void close(void);
+};
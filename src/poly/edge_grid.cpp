@@ -0,0 +1,291 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "edge_grid.hpp"
+#include "polygon.hpp"
+#include "split_stats.hpp"
+#include "split_trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace poly_private;
+
+EdgeGrid::EdgeGrid(const Points &ring) {
+    assign(ring);
+}
+
+void EdgeGrid::assign(const Points &vertices) {
+    ring = vertices;
+    edges.clear();
+    norms.clear();
+    boxes.clear();
+    cell_start.clear();
+    cell_edges.clear();
+    origin = Point{};
+    cell_w = 1;
+    cell_h = 1;
+    cols = 1;
+    rows = 1;
+    margin = POLY_SPLIT_EPS;
+
+    size_t n{ring.size()};
+    if (n == 0)
+        return;
+
+    // The boxes are enlarged by the tolerance of Segment::cross_line,
+    // so every edge lies in all the cells where it can be crossed
+    edges.reserve(n);
+    norms.reserve(n);
+    boxes.reserve(n);
+    Box bounds{ring[0].x, ring[0].y, ring[0].x, ring[0].y};
+    for (size_t i = 0; i < n; i++) {
+        const Point &p1{ring[i]};
+        const Point &p2{ring[i + 1 < n ? i + 1 : 0]};
+        edges.push_back(Segment{p1, p2});
+        norms.push_back(edges.back().norm());
+        boxes.push_back(Box{std::min(p1.x, p2.x) - POLY_SPLIT_EPS, std::min(p1.y, p2.y) - POLY_SPLIT_EPS,
+                            std::max(p1.x, p2.x) + POLY_SPLIT_EPS, std::max(p1.y, p2.y) + POLY_SPLIT_EPS});
+
+        bounds.min_x = std::min(bounds.min_x, boxes.back().min_x);
+        bounds.min_y = std::min(bounds.min_y, boxes.back().min_y);
+        bounds.max_x = std::max(bounds.max_x, boxes.back().max_x);
+        bounds.max_y = std::max(bounds.max_y, boxes.back().max_y);
+    }
+
+    // Around one edge per cell
+    double w{bounds.max_x - bounds.min_x};
+    double h{bounds.max_y - bounds.min_y};
+    cols = static_cast<size_t>(std::clamp(sqrt(n * w / h), 1.0, static_cast<double>(n)));
+    rows = std::clamp((n + cols - 1) / cols, size_t{1}, n);
+
+    origin = Point{bounds.min_x, bounds.min_y};
+    cell_w = w / cols;
+    cell_h = h / rows;
+    margin = POLY_SPLIT_EPS + 1E-3 * std::min(cell_w, cell_h);
+
+    // The rows around the ones of the box are tried too, as row_cols
+    // decides which rows the edge passes
+    auto edge_rows{[&](size_t i, size_t &r1, size_t &r2) {
+        r1 = row(boxes[i].min_y - margin);
+        r1 = r1 > 0 ? r1 - 1 : 0;
+        r2 = std::min(row(boxes[i].max_y + margin) + 1, rows - 1);
+    }};
+
+    cell_start.assign(cols * rows + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+        size_t r1, r2;
+        edge_rows(i, r1, r2);
+        for (size_t r = r1; r <= r2; r++) {
+            size_t c1, c2;
+            if (!row_cols(ring[i], ring[i + 1 < n ? i + 1 : 0], r, c1, c2))
+                continue;
+
+            for (size_t c = c1; c <= c2; c++) {
+                cell_start[r * cols + c + 1]++;
+            }
+        }
+    }
+
+    for (size_t k = 1; k < cell_start.size(); k++) {
+        cell_start[k] += cell_start[k - 1];
+    }
+
+    cell_edges.resize(cell_start.back());
+    cell_fill.assign(cell_start.begin(), cell_start.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        size_t r1, r2;
+        edge_rows(i, r1, r2);
+        for (size_t r = r1; r <= r2; r++) {
+            size_t c1, c2;
+            if (!row_cols(ring[i], ring[i + 1 < n ? i + 1 : 0], r, c1, c2))
+                continue;
+
+            for (size_t c = c1; c <= c2; c++) {
+                cell_edges[cell_fill[r * cols + c]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
+
+double EdgeGrid::min_sq_length(size_t i, size_t j) const {
+    const Box &a{boxes[i]};
+    const Box &b{boxes[j]};
+
+    // The gap along one axis is not longer than the distance of the
+    // edges, and the enlarged boxes only make it shorter
+    double gap{std::max({a.min_x - b.max_x, b.min_x - a.max_x, a.min_y - b.max_y, b.min_y - a.max_y})};
+    gap -= 4.0 * POLY_SPLIT_EPS;
+
+    return gap > 0 ? gap * gap : 0;
+}
+
+size_t EdgeGrid::col(double x) const {
+    double c{(x - origin.x) / cell_w};
+    if (!(c > 0))
+        return 0;
+    if (c >= cols)
+        return cols - 1;
+
+    return static_cast<size_t>(c);
+}
+
+size_t EdgeGrid::row(double y) const {
+    double r{(y - origin.y) / cell_h};
+    if (!(r > 0))
+        return 0;
+    if (r >= rows)
+        return rows - 1;
+
+    return static_cast<size_t>(r);
+}
+
+bool EdgeGrid::row_cols(const Point &start, const Point &end, size_t r, size_t &c1, size_t &c2) const {
+    // The border rows also hold everything beyond the grid
+    double y1{r == 0 ? -HUGE_VAL : origin.y + r * cell_h - margin};
+    double y2{r == rows - 1 ? HUGE_VAL : origin.y + (r + 1) * cell_h + margin};
+    double dy{end.y - start.y};
+
+    double t1{0};
+    double t2{1};
+    if (dy != 0) {
+        t1 = (y1 - start.y) / dy;
+        t2 = (y2 - start.y) / dy;
+        if (t1 > t2)
+            std::swap(t1, t2);
+
+        t1 = std::max(t1, 0.0);
+        t2 = std::min(t2, 1.0);
+        if (t1 > t2)
+            return false;
+    } else if (start.y < y1 || y2 < start.y) {
+        return false;
+    }
+
+    // Every step is monotonic in r, so are the columns, and the rows of
+    // a segment that reach some columns are consecutive
+    double x1{start.x + (end.x - start.x) * t1};
+    double x2{start.x + (end.x - start.x) * t2};
+    c1 = col(std::min(x1, x2) - margin);
+    c2 = col(std::max(x1, x2) + margin);
+
+    return true;
+}
+
+bool EdgeGrid::is_segment_inside(const Segment &segment, size_t exclude_line1, size_t exclude_line2) const {
+    if (ring.size() < 3)
+        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+
+    POLY_SPLIT_TRACE_SCOPE("is_segment_inside");
+    POLY_SPLIT_COUNT(inside_checks, 1);
+    if (crosses(segment, exclude_line1, exclude_line2))
+        return false;
+
+    return is_point_inside(segment.get_point_along(0.5));
+}
+
+bool EdgeGrid::crosses(const Segment &segment, size_t exclude_line1, size_t exclude_line2) const {
+    size_t n{ring.size()};
+    Point start{segment.get_start()};
+    Point end{segment.get_end()};
+    Box query{std::min(start.x, end.x) - POLY_SPLIT_EPS, std::min(start.y, end.y) - POLY_SPLIT_EPS,
+              std::max(start.x, end.x) + POLY_SPLIT_EPS, std::max(start.y, end.y) + POLY_SPLIT_EPS};
+
+    // Only the cells along the segment are visited
+    for (size_t r = row(query.min_y); r <= row(query.max_y); r++) {
+        size_t c1, c2;
+        if (!row_cols(start, end, r, c1, c2))
+            continue;
+
+        for (size_t k = cell_start[r * cols + c1]; k < cell_start[r * cols + c2 + 1]; k++) {
+            size_t i{cell_edges[k]};
+            if (i == exclude_line1 || i == exclude_line2)
+                continue;
+
+            const Box &box{boxes[i]};
+            if (box.max_x < query.min_x || query.max_x < box.min_x ||
+                box.max_y < query.min_y || query.max_y < box.min_y)
+                continue;
+
+            Point p1{ring[i]};
+            Point p2{ring[i + 1 < n ? i + 1 : 0]};
+            Point p;
+            POLY_SPLIT_COUNT(intersection_tests, 1);
+            if ((edges[i].cross_line(segment, p)) and
+                (p1.square_distance(p) > POLY_SPLIT_EPS) and
+                (p2.square_distance(p) > POLY_SPLIT_EPS)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool EdgeGrid::is_point_inside(const Point &point) const {
+    if (ring.size() < 3)
+        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+
+    // The same ray as Polygon::is_point_inside
+    Segment s{Line{point, Vector{0.0, 1e100}}};
+    Box query{point.x - POLY_SPLIT_EPS, point.y - POLY_SPLIT_EPS, point.x + POLY_SPLIT_EPS, HUGE_VAL};
+
+    size_t c1{col(query.min_x)};
+    size_t c2{col(query.max_x)};
+    size_t r1{row(query.min_y)};
+
+    size_t n{ring.size()};
+    int result{0};
+    Point p;
+    for (size_t r = r1; r < rows; r++) {
+        for (size_t c = c1; c <= c2; c++) {
+            size_t cell{r * cols + c};
+            for (size_t k = cell_start[cell]; k < cell_start[cell + 1]; k++) {
+                size_t i{cell_edges[k]};
+                const Box &box{boxes[i]};
+                if (box.max_x < query.min_x || query.max_x < box.min_x || box.max_y < query.min_y)
+                    continue;
+
+                // An edge lies in several cells, but it is only counted
+                // in the first one shared with the ray
+                const Point &p1{ring[i]};
+                const Point &p2{ring[i + 1 < n ? i + 1 : 0]};
+                size_t e1{0};
+                size_t e2{0};
+                if (!row_cols(p1, p2, r, e1, e2) || c != std::max(c1, e1))
+                    continue;
+                if (r > r1 && row_cols(p1, p2, r - 1, e1, e2) && e1 <= c2 && c1 <= e2)
+                    continue;
+
+                POLY_SPLIT_COUNT(intersection_tests, 1);
+                result += s.cross_line(edges[i], p);
+            }
+        }
+    }
+
+    return result % 2 != 0;
+}
+
+size_t EdgeGrid::memory(void) const {
+    return ring.capacity() * sizeof(Point) + edges.capacity() * sizeof(Segment) +
+           norms.capacity() * sizeof(double) + boxes.capacity() * sizeof(Box) +
+           (cell_start.capacity() + cell_fill.capacity()) * sizeof(size_t) +
+           cell_edges.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,138 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "line.hpp"
+
+namespace poly_private {
+/**
+ * @brief Uniform grid over the edges of a ring. Every edge is kept in
+ * the cells that it passes, so long edges do not fill their whole box.
+ * It answers the same questions as Polygon::is_segment_inside and
+ * Polygon::is_point_inside, but only visits the edges near the query.
+*/
+class EdgeGrid {
+    private:
+        struct Box {
+            double min_x, min_y, max_x, max_y;
+        };
+
+        Points ring;
+        std::vector<Segment> edges;
+        // Segment::norm of every edge
+        std::vector<double> norms;
+        std::vector<Box> boxes;
+
+        Point origin;
+        double cell_w{1};
+        double cell_h{1};
+        size_t cols{1};
+        size_t rows{1};
+
+        // Distance to the edges within which their cells are taken, for
+        // the tolerance of Segment::cross_line and the rounding
+        double margin{POLY_SPLIT_EPS};
+
+        // Edges of every cell, stored consecutively. Their indices take
+        // most of the memory, so they are kept in 32 bits
+        std::vector<size_t> cell_start;
+        std::vector<uint32_t> cell_edges;
+        // Next free place of every cell while they are filled
+        std::vector<size_t> cell_fill;
+
+        size_t col(double x) const;
+        size_t row(double y) const;
+
+        /**
+         * @brief Finds the columns c1 to c2 of the row r that hold the
+         * points of the segment, or the points near it by less than the
+         * margin. Returns false when the segment does not pass the row.
+        */
+        bool row_cols(const Point &start, const Point &end, size_t r, size_t &c1, size_t &c2) const;
+
+    public:
+        EdgeGrid() = default;
+        EdgeGrid(const Points &ring);
+
+        /**
+         * @brief Builds the grid of another ring, reusing the memory.
+        */
+        void assign(const Points &ring);
+
+        /**
+         * @brief Returns the edge that starts at the vertex of the index,
+         * the same segment as the one built from its two vertices.
+        */
+        const Segment &edge(size_t index) const {
+            return edges[index];
+        }
+
+        /**
+         * @brief Returns the norm of the edge, computed once for all the
+         * pairs that use it.
+        */
+        double norm(size_t index) const {
+            return norms[index];
+        }
+
+        /**
+         * @brief Returns a lower bound of Polygons::min_sq_length of the
+         * edges i and j from the gap between their boxes, without the
+         * square roots of the distances between their end points.
+        */
+        double min_sq_length(size_t i, size_t j) const;
+
+        /**
+         * @brief Returns true if the segment passed by parameters is
+         * contained within the edges of the ring.
+         *
+         * @param
+         * exclude_line1: The index of the first edge to be disregarded in the analysis.
+         * @param
+         * exclude_line2: The index of the second edge to be disregarded in the analysis.
+         *
+         * @throws
+         * Polygon::NotEnoughPointsException: if the ring has less than three vertices.
+        */
+        bool is_segment_inside(const Segment &segment, size_t exclude_line1, size_t exclude_line2) const;
+
+        /**
+         * @brief Returns true if the segment crosses an edge of the ring
+         * away from its vertices, like Polygon::is_segment_inside checks
+         * before the middle point. The excluded edges are not checked.
+        */
+        bool crosses(const Segment &segment, size_t exclude_line1, size_t exclude_line2) const;
+
+        /**
+         * @brief Returns true if the point passed by parameters is contained
+         * within the edges of the ring.
+         *
+         * @throws
+         * Polygon::NotEnoughPointsException: if the ring has less than three vertices.
+        */
+        bool is_point_inside(const Point &point) const;
+
+        /**
+         * @brief Returns the bytes reserved by the grid.
+        */
+        size_t memory(void) const;
+};
+};
@@ -0,0 +1,283 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "incremental_split.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace poly_private;
+
+void IncrementalSplit::clear(void) {
+    vertices.clear();
+    polygon.clear();
+    values.clear();
+    states.clear();
+    moved.clear();
+    changes.clear();
+    swept.clear();
+    has_result = false;
+}
+
+void IncrementalSplit::reset(const Points &points, double area) {
+    size_t n{points.size()};
+
+    vertices = points;
+    polygon = points;
+    reversed = !Polygon{points}.is_clockwise();
+    if (reversed) {
+        std::reverse(polygon.begin(), polygon.end());
+    }
+    square = area;
+
+    values.assign(n * (n - 1) / 2, 0);
+    states.assign(n * (n - 1) / 2, PairState::Unknown);
+    moved.clear();
+    changes.clear();
+    swept.clear();
+    has_result = false;
+}
+
+bool IncrementalSplit::update(const Points &points, double area) {
+    size_t n{points.size()};
+    if (n != vertices.size() || area != square || Polygon{points}.is_clockwise() == reversed) {
+        reset(points, area);
+        return true;
+    }
+
+    for (size_t k = 0; k < n; k++) {
+        // Point::operator== has a tolerance, but any move changes the cut
+        if (points[k].x == vertices[k].x && points[k].y == vertices[k].y)
+            continue;
+
+        if (moved.size() == max_moved) {
+            reset(points, area);
+            return true;
+        }
+
+        size_t v{reversed ? n - 1 - k : k};
+        const Point &prev{polygon[(v + n - 1) % n]};
+        const Point &next{polygon[(v + 1) % n]};
+        const Point &p{points[k]};
+
+        // The edges of the vertex sweep the hull of their old and new
+        // positions, enlarged by the tolerance of Segment::cross_line
+        double margin{4.0 * POLY_SPLIT_EPS};
+        swept.push_back(Box{std::min({prev.x, next.x, polygon[v].x, p.x}) - margin,
+                            std::min({prev.y, next.y, polygon[v].y, p.y}) - margin,
+                            std::max({prev.x, next.x, polygon[v].x, p.x}) + margin,
+                            std::max({prev.y, next.y, polygon[v].y, p.y}) + margin});
+        // Signed area that the move adds to the polygon, and to any part
+        // that has the vertex and its neighbours
+        Point d{p - polygon[v]};
+        Point chord{prev - next};
+        changes.push_back(-(chord.x * d.y - d.x * chord.y) / 2.0);
+
+        moved.push_back(v);
+        polygon[v] = p;
+    }
+
+    vertices = points;
+    return !has_result || !moved.empty();
+}
+
+bool IncrementalSplit::near_moved(const Segment &cut) const {
+    const Point a{cut.get_start()};
+    const Point b{cut.get_end()};
+    const Point m{cut.get_point_along(0.5)};
+
+    for (const Box &box : swept) {
+        if (box.min_x <= std::max(a.x, b.x) && std::min(a.x, b.x) <= box.max_x &&
+            box.min_y <= std::max(a.y, b.y) && std::min(a.y, b.y) <= box.max_y)
+            return true;
+
+        // The ray of is_point_inside goes up from the middle of the cut
+        if (box.min_x <= m.x && m.x <= box.max_x && m.y <= box.max_y)
+            return true;
+    }
+
+    return false;
+}
+
+void IncrementalSplit::search(void) {
+    size_t n{polygon.size()};
+
+    AreaTable &areas{workspace.areas};
+    EdgeBlocks &blocks{workspace.blocks};
+    EdgeGrid &edges{workspace.edges};
+    areas.assign(polygon);
+    blocks.assign(polygon);
+    edges.assign(polygon);
+
+    // Edges that end at a moved vertex
+    std::vector<bool> edge_moved(n, false);
+    for (size_t v : moved) {
+        edge_moved[v] = true;
+        edge_moved[(v + n - 1) % n] = true;
+    }
+
+    // The targets of the previous call are found again up to the
+    // rounding of the areas, which grows with the area of the polygon
+    double tolerance{POLY_SPLIT_EPS + rounding * fabs(areas.count_square_signed(0, n))};
+
+    SplitCandidate best;
+    auto check{[&](size_t i, size_t j, const Segment &cut, bool known) {
+        size_t k{pair(i, j)};
+        if (!known) {
+            states[k] = edges.is_segment_inside(cut, i, j) ? PairState::Valid : PairState::Invalid;
+        }
+
+        if (states[k] == PairState::Valid) {
+            best.exists = true;
+            best.sq_length = values[k];
+            best.i = static_cast<int>(i);
+            best.j = static_cast<int>(j);
+            best.cut = cut;
+        }
+    }};
+
+    // The pairs are visited in the order of Polygon::split, and a cut
+    // only wins if it is shorter, so the ties are resolved the same way
+    for (size_t i = 0; i + 1 < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            if (j == i + 1 || j % EdgeBlocks::size == 0) {
+                size_t block{j / EdgeBlocks::size};
+                if (blocks.min_sq_length(i, block) > best.sq_length) {
+                    size_t end{std::min((block + 1) * EdgeBlocks::size, n)};
+                    for (; j < end; j++) {
+                        states[pair(i, j)] = PairState::Pruned;
+                        values[pair(i, j)] = best.sq_length;
+                    }
+                    j = end - 1;
+                    continue;
+                }
+            }
+
+            size_t k{pair(i, j)};
+            size_t pc1{j - i};
+            double square1{areas.count_square_signed(i + 1, pc1)};
+            double square2{areas.count_square_signed((j + 1) % n, n - pc1)};
+
+            // The cut of the pair only depends on its edges, on whether
+            // it is reversed and on the area of the part that it leaves,
+            // the one of the vertices after j unless it is reversed
+            bool dirty{states[k] == PairState::Unknown};
+            if (!dirty && !moved.empty()) {
+                bool in_p1{false};
+                bool in_p2{false};
+                double change2{0};
+                for (size_t m = 0; m < moved.size(); m++) {
+                    if (i < moved[m] && moved[m] <= j) {
+                        in_p1 = true;
+                    } else {
+                        in_p2 = true;
+                        change2 += changes[m];
+                    }
+                }
+
+                bool reversed_cut{square + square2 <= 0};
+                double previous{square + square2 - change2};
+                dirty = edge_moved[i] || edge_moved[j] || (reversed_cut ? in_p1 : in_p2) ||
+                        (previous <= 0) != reversed_cut || fabs(previous) <= tolerance;
+            }
+
+            Segment cut;
+
+            if (!dirty && states[k] == PairState::Missing)
+                continue;
+
+            if (!dirty && states[k] != PairState::Pruned) {
+                // The length was found with the areas of a previous call,
+                // so the ties are searched again to resolve them the same way
+                if (values[k] * (1.0 - rounding) > best.sq_length) {
+                    // The moved edges may have changed whether it is inside
+                    if (!moved.empty())
+                        states[k] = PairState::Cut;
+                    continue;
+                }
+
+                if (Polygon::get_cut(edges, i, j, square, square1, square2, DBL_MAX, cut) != CutSearch::Found) {
+                    states[k] = PairState::Missing;
+                    continue;
+                }
+
+                values[k] = cut.square_length();
+                if (values[k] >= best.sq_length) {
+                    states[k] = PairState::Cut;
+                } else {
+                    check(i, j, cut, states[k] != PairState::Cut && !near_moved(cut));
+                }
+                continue;
+            }
+
+            if (!dirty && values[k] >= best.sq_length)
+                continue;
+
+            switch (Polygon::get_cut(edges, i, j, square, square1, square2, best.sq_length, cut)) {
+                case CutSearch::Missing:
+                    states[k] = PairState::Missing;
+                    break;
+                case CutSearch::Pruned:
+                    states[k] = PairState::Pruned;
+                    values[k] = best.sq_length;
+                    break;
+                case CutSearch::Found:
+                    values[k] = cut.square_length();
+                    if (values[k] < best.sq_length) {
+                        check(i, j, cut, false);
+                    } else {
+                        states[k] = PairState::Cut;
+                    }
+                    break;
+            }
+        }
+    }
+
+    result = best;
+    has_result = true;
+    moved.clear();
+    changes.clear();
+    swept.clear();
+}
+
+void IncrementalSplit::split(const Polygon &p, double area, Polygon &poly1, Polygon &poly2,
+                             Segment &cut_line) {
+    // The polygons that can not be split fail like Polygon::split
+    if (p.size() < 3 || p.count_square() - area <= POLY_SPLIT_EPS) {
+        clear();
+        p.split(area, poly1, poly2, cut_line, workspace);
+        return;
+    }
+
+    if (update(p.vertices, area)) {
+        search();
+    }
+
+    poly1.clear();
+    poly2.clear();
+
+    if (result.exists) {
+        Polygon::split_parts(polygon, result, poly1, poly2, cut_line);
+    } else {
+        poly1 = Polygon{polygon};
+        throw Polygon::CannotSplitException{"The cut line does not exists"};
+    }
+}
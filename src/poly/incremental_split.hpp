@@ -0,0 +1,129 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "polygon.hpp"
+#include "split_workspace.hpp"
+
+/**
+ * @brief Repeats Polygon::split on a polygon that changes a few vertices
+ * at a time, like one being dragged in an editor. The outcome of every
+ * edge pair is kept between the calls, and only the pairs whose edges or
+ * area changed are searched again. The rest are reused unless their cut
+ * could be the shortest one, and then it is only checked against the
+ * edges again when it is near a moved vertex.
+ *
+ * Only these searches and checks are saved. Every call that sees a move
+ * still rebuilds the area table, the edge blocks and the edge grid, and
+ * visits all the edge pairs, and the records take a double and a byte
+ * for each pair, so the memory grows with the square of the vertices.
+ *
+ * It gives the same cut as Polygon::split, up to the rounding of the
+ * areas.
+*/
+class IncrementalSplit {
+    private:
+        enum class PairState : uint8_t {
+            // The pair has to be searched
+            Unknown,
+            // No cut between the edges leaves the area
+            Missing,
+            // Any cut is longer than the value
+            Pruned,
+            // The value is the length of a cut not checked yet
+            Cut,
+            // The cut is inside the polygon
+            Valid,
+            // The cut crosses the polygon
+            Invalid
+        };
+
+        // More moved vertices dirty almost every pair
+        static const size_t max_moved{8};
+
+        // Relative error of the cached lengths of the cuts
+        static constexpr double rounding{1E-9};
+
+        struct Box {
+            double min_x, min_y, max_x, max_y;
+        };
+
+        // Vertices as they were passed, and their clockwise copy
+        Points vertices;
+        Points polygon;
+        bool reversed{false};
+        double square{0};
+
+        // Area and squares of the lengths of the pairs i < j, row by row
+        std::vector<double> values;
+        std::vector<PairState> states;
+
+        // Vertices of the clockwise copy that moved since the last call,
+        // the signed area each move added and the boxes swept by their
+        // edges
+        std::vector<size_t> moved;
+        std::vector<double> changes;
+        std::vector<Box> swept;
+
+        bool has_result{false};
+        poly_private::SplitCandidate result;
+
+        // The search structures, kept between the calls
+        SplitWorkspace workspace;
+
+        size_t pair(size_t i, size_t j) const {
+            return i * polygon.size() - i * (i + 1) / 2 + (j - i - 1);
+        }
+
+        /**
+         * @brief Takes the new vertices. Returns false when the records
+         * can not be reused and have been reset.
+        */
+        bool update(const Points &points, double area);
+        void reset(const Points &points, double area);
+
+        /**
+         * @brief Returns true if an edge near the moved vertices could
+         * change whether the cut is inside the polygon.
+        */
+        bool near_moved(const Segment &cut) const;
+
+        void search(void);
+
+    public:
+        IncrementalSplit() = default;
+
+        /**
+         * @brief Same as Polygon::split. It reuses the work of the previous
+         * call when the polygon has the same number of vertices and only
+         * a few of them moved, and the area is the same.
+         *
+         * @throws
+         * Polygon::CannotSplitException: like Polygon::split.
+        */
+        void split(const Polygon &polygon, double square, Polygon &poly1, Polygon &poly2,
+                   Segment &cut_line);
+
+        /**
+         * @brief Forgets the previous polygon.
+        */
+        void clear(void);
+};
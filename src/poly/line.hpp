@@ -1,6 +1,5 @@
 /**
  * The MIT License (MIT)
- * Copyright (c) 2016 Grabarchuk Viktor
  * Copyright (c) 2023 Pablo López Sedeño
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the “Software”), to deal
@@ -21,63 +20,159 @@
 
 #pragma once
 
+#include "predicates.hpp"
 #include "vector.hpp"
 
+#include <cassert>
+
 enum class PointSide {
     Above,
     Inside,
     Below
 };
 
-class Line {
+namespace poly_private {
+template <typename T>
+constexpr bool inside(T v, T min, T max) {
+    return ((min <= (v + ScalarTraits<T>::eps)) and (v <= (max + ScalarTraits<T>::eps)));
+}
+
+template <typename T>
+constexpr T det(T a, T b, T c, T d) {
+    return (((a) * (d)) - ((b) * (c)));
+}
+
+template <typename T>
+constexpr T minimum(T a, T b) {
+    return (((a) > (b)) ? (b) : (a));
+}
+
+template <typename T>
+constexpr T maximum(T a, T b) {
+    return (((a) < (b)) ? (b) : (a));
+}
+};
+
+template <typename T>
+class BasicSegment;
+
+/**
+ * @brief A line through two points. The coefficients need a floating
+ * point coordinate type.
+*/
+template <typename T>
+class BasicLine {
+    static_assert(std::is_floating_point_v<T>, "The lines need floating point coordinates");
+
+    using Traits = ScalarTraits<T>;
+    using Point = BasicPoint<T>;
+    using Vector = BasicVector<T>;
+    using Line = BasicLine<T>;
+
     private:
-        double a{0}; // -Increase of y
-        double b{0}; // Increase of x
-        double c{0}; // Determinant of the segment
+        T a{0}; // -Increase of y
+        T b{0}; // Increase of x
+        T c{0}; // Determinant of the segment
         Point p1, p2;
 
     public:
-        Line();
-        Line(const Line &other);
-        Line(const Point &p1, const Point &p2);
-        Line(double a, double b, double c);
-        Line(Point p, Vector v);
+        constexpr BasicLine() = default;
+
+        constexpr BasicLine(const Point &p1, const Point &p2) : p1(p1), p2(p2) {
+            a = p1.y - p2.y;
+            b = p2.x - p1.x;
+            c = p1.x * p2.y - p2.x * p1.y;
+        }
+
+        constexpr BasicLine(T a, T b, T c) : a{a}, b{b}, c{c} {
+            if (poly_private::abs(a) <= Traits::eps && poly_private::abs(b) >= Traits::eps) {
+                p1.x = T(-1000);
+                p1.y = -(c / b);
+
+                p2.x = T(1000);
+                p2.y = p1.y;
+            } else if (poly_private::abs(b) <= Traits::eps && poly_private::abs(a) >= Traits::eps) {
+                p1.x = -(c / a);
+                p1.y = T(-1000);
+
+                p2.x = p1.x;
+                p2.y = T(1000);
+            } else {
+                p1.x = T(-1000);
+                p1.y = -((a * p1.x + c) / b);
+
+                p2.x = T(1000);
+                p2.y = -((a * p2.x + c) / b);
+            }
+        }
+
+        constexpr BasicLine(Point p, Vector v) : BasicLine(p, p + v) {}
 
         /**
          * @brief It returns the start point of the segment
         */
-        Point get_p1() const;
+        constexpr Point get_p1() const {
+            return p1;
+        }
 
         /**
          * @brief It returns the end point of the segment
         */
-        Point get_p2() const;
+        constexpr Point get_p2() const {
+            return p2;
+        }
 
         /**
          * @brief It returns the square of the length of the segment
         */
-        double square_length() const;
+        constexpr T square_length() const {
+            T x{p2.x - p1.x};
+            T y{p2.y - p1.y};
+
+            return x * x + y * y;
+        }
 
         /**
          * @brief Returns a point on the line one distance t away from
          * the start point
         */
-        Point get_point_along(double t) const;
+        Point get_point_along(T t) const {
+            return p1 + Vector{p2 - p1}.unit() * t;
+        }
 
         /**
          * @brief Returns the distance between the point and the line
         */
-        double get_distance(const Point &point) const;
+        T get_distance(const Point &point) const {
+            T n{a * point.x + b * point.y + c};
+            T m{std::sqrt(a * a + b * b)};
+            assert(m != 0);
+            return n / m;
+        }
 
         /**
          * @brief Returns the nearest point from the line
         */
-        Point get_nearest_point(const Point &point) const;
+        constexpr Point get_nearest_point(const Point &point) const {
+            Vector dir{b, -a};
+            T u{Vector{point - p1}.dot(dir) / dir.square_length()};
+            return p1 + dir * u;
+        }
 
         /**
-         * @brief Returns if the point is over, under or in the line
+         * @brief Returns if the point is over, under or in the line. The
+         * answer is exact for the line through p1 and p2
         */
-        PointSide point_side(const Point &point) const;
+        constexpr PointSide point_side(const Point &point) const {
+            T s{poly_private::orient2d(p1.x, p1.y, p2.x, p2.y, point.x, point.y)};
+            if (s > 0) {
+                return PointSide::Above;
+            } else if (s < 0) {
+                return PointSide::Below;
+            } else {
+                return PointSide::Inside;
+            }
+        }
 
         /**
          * @brief Returns whether the two lines intersect and
@@ -88,87 +183,208 @@ class Line {
          * 
          * @return If the line and the segment intersect
         */
-        bool cross_line(const Line &line, Point &result) const;
+        constexpr bool cross_line(const Line &line, Point &result) const {
+            using namespace poly_private;
 
-        bool operator==(const Line &other) const;
+            // Zero only for exactly parallel lines through their points
+            if (cross2d(p1.x, p1.y, p2.x, p2.y, line.p1.x, line.p1.y, line.p2.x, line.p2.y) == 0)
+                return false;
 
-        Line &operator=(const Line &other);
+            // The rounded coefficients can still be parallel
+            T d{det2(a, b, line.a, line.b)};
+            if (d == 0)
+                return false;
+
+            result.x = -det(c, b, line.c, line.b) / d;
+            result.y = -det(a, c, line.a, line.c) / d;
+
+            return true;
+        }
+
+        constexpr bool operator==(const Line &other) const {
+            return (point_side(other.p1) == PointSide::Inside) and (point_side(other.p2) == PointSide::Inside);
+        }
 
         /**
          * @brief Returns the bisector between the two lines
         */
-        static Line get_bisector(const Line &l1, const Line &l2);
+        static Line get_bisector(const Line &l1, const Line &l2) {
+            if (l1 == l2) {
+                return Line{l1};
+            } else {
+                T q1{std::sqrt(l1.a * l1.a + l1.b * l1.b)};
+                T q2{std::sqrt(l2.a * l2.a + l2.b * l2.b)};
+
+                T a{l1.a / q1 - l2.a / q2};
+                T b{l1.b / q1 - l2.b / q2};
+                T c{l1.c / q1 - l2.c / q2};
+
+                return Line{a, b, c};
+            }
+        }
 
         /**
          * @brief Returns the tangent of the angle between the two lines in radians
         */
-        static double get_tan_angle(const Line &l1, const Line &l2);
+        static constexpr T get_tan_angle(const Line &l1, const Line &l2) {
+            return (l1.a * l2.b - l2.a * l1.b) / (l1.a * l2.a + l1.b * l2.b);
+        }
 
-        friend std::ostream &operator<<(std::ostream &out, const Line &l);
-        friend class Segment;
+        friend std::ostream &operator<<(std::ostream &out, const Line &l) {
+            out << "[" << l.a << ", " << l.b << ", " << l.c << "]-{" << l.p1 << ", " << l.p2 << "}";
+            return out;
+        }
+
+        friend class BasicSegment<T>;
 };
 
-class Segment {
+/**
+ * @brief A line between its two points. The start and end points are
+ * the ones of the line.
+*/
+template <typename T>
+class BasicSegment {
+    using Traits = ScalarTraits<T>;
+    using Point = BasicPoint<T>;
+    using Line = BasicLine<T>;
+    using Segment = BasicSegment<T>;
+
     private:
         Line l;
-        Point &start = l.p1;
-        Point &end = l.p2;
+
+        // Whether the point is within the tolerance of the segment, given
+        // its orient2d value, which is the distance times the length
+        constexpr bool touches(const Point &point, T side) const {
+            using namespace poly_private;
+
+            return side * side <= Traits::eps * Traits::eps * square_length() &&
+                   inside(point.x, minimum(l.p1.x, l.p2.x), maximum(l.p1.x, l.p2.x)) &&
+                   inside(point.y, minimum(l.p1.y, l.p2.y), maximum(l.p1.y, l.p2.y));
+        }
+
+        // Whether the point is in the box of the segment
+        constexpr bool contains(const Point &point) const {
+            using namespace poly_private;
+
+            return minimum(l.p1.x, l.p2.x) <= point.x && point.x <= maximum(l.p1.x, l.p2.x) &&
+                   minimum(l.p1.y, l.p2.y) <= point.y && point.y <= maximum(l.p1.y, l.p2.y);
+        }
+
+        // The point where a line crosses the segment, given the orient2d
+        // values of the start and end points, which have opposite signs
+        constexpr Point point_between(T side1, T side2) const {
+            T t{side1 / (side1 - side2)};
+            return Point{l.p1.x + (l.p2.x - l.p1.x) * t, l.p1.y + (l.p2.y - l.p1.y) * t};
+        }
+
+        // Moves a rounded point of the line back into the box of the segment
+        constexpr void clamp(Point &point) const {
+            using namespace poly_private;
+
+            point.x = maximum(minimum(point.x, maximum(l.p1.x, l.p2.x)), minimum(l.p1.x, l.p2.x));
+            point.y = maximum(minimum(point.y, maximum(l.p1.y, l.p2.y)), minimum(l.p1.y, l.p2.y));
+        }
 
     public:
-        Segment();
-        Segment(const Segment &s);
-        Segment(const Line &l);
-        Segment(const Point &start, const Point &end);
-        Line make_line() const;
+        constexpr BasicSegment() = default;
+        constexpr BasicSegment(const Line &l) : l{l} {}
+        constexpr BasicSegment(const Point &start, const Point &end) : l{start, end} {}
+
+        constexpr Line make_line() const {
+            return Line{l.a, l.b, l.c};
+        }
 
         /**
          * @brief It returns the start point of the segment
         */
-        Point get_start() const;
+        constexpr Point get_start() const {
+            return l.p1;
+        }
 
         /**
          * @brief It returns the end point of the segment
         */
-        Point get_end() const;
+        constexpr Point get_end() const {
+            return l.p2;
+        }
 
         /**
          * @brief It returns the length of the segment
         */
-        double length() const;
+        T length() const {
+            return l.p1.distance(l.p2);
+        }
 
         /**
          * @brief It returns the square of the length of the segment
         */
-        double square_length() const;
+        constexpr T square_length() const {
+            return l.p1.square_distance(l.p2);
+        }
+
+        /**
+         * @brief Returns the length of the normal of the line, the one
+         * that get_bisector divides its coefficients by
+        */
+        T norm() const {
+            return std::sqrt(l.a * l.a + l.b * l.b);
+        }
 
         /**
          * @brief It returns the same segment but the start point is
          * the new end point and vice versa
         */
-        Segment reverse() const;
+        constexpr Segment reverse() const {
+            return Segment{l.p2, l.p1};
+        }
 
         /**
          * @brief Returns a point on the line one distance t away from
          * the start point
         */
-        Point get_point_along(double t) const;
+        Point get_point_along(T t) const {
+            using namespace poly_private;
+
+            Point p{l.get_point_along(t)};
+            Point min{minimum(l.p1.x, l.p2.x), minimum(l.p1.y, l.p2.y)};
+            Point max{maximum(l.p1.x, l.p2.x), maximum(l.p1.y, l.p2.y)};
+
+            if (!inside(p.x, min.x, max.x) or (!inside(p.y, min.y, max.y))) {
+                p = get_nearest_point(p);
+            }
+
+            return p;
+        }
 
         /**
          * @brief Returns the distance between the point and the line
         */
-        double get_distance(const Point &point) const;
+        T get_distance(const Point &point) const {
+            return l.get_distance(point);
+        }
 
         /**
          * @brief Returns the nearest point from the segment,
          * which means that it takes into account the start
          * and end points
         */
-        Point get_nearest_point(const Point &point) const;
+        constexpr Point get_nearest_point(const Point &point) const {
+            Vector dir{l.b, -l.a};
+            T u{Vector{point - l.p1}.dot(dir) / dir.square_length()};
+            if (u < 0)
+                return l.p1;
+            else if (u > 1)
+                return l.p2;
+            else
+                return l.p1 + dir * u;
+        }
 
         /**
          * @brief Returns if the point is over, under or in the line
         */
-        PointSide point_side(const Point &point) const;
+        constexpr PointSide point_side(const Point &point) const {
+            return l.point_side(point);
+        }
 
         /**
          * @brief Returns whether the line and the segment intersect and
@@ -182,7 +398,36 @@ class Segment {
          * 
          * @return If the line and the segment intersect
         */
-        bool cross_line(const Line &line, Point &result) const;
+        constexpr bool cross_line(const Line &line, Point &result) const {
+            using namespace poly_private;
+
+            // The sides of the ends decide the crossing exactly, and an
+            // end within the tolerance of the line touches it
+            T s1{orient2d(line.p1.x, line.p1.y, line.p2.x, line.p2.y, l.p1.x, l.p1.y)};
+            T s2{orient2d(line.p1.x, line.p1.y, line.p2.x, line.p2.y, l.p2.x, l.p2.y)};
+            if (s1 == 0 && s2 == 0)
+                return false;
+
+            if ((s1 < 0 && s2 > 0) || (s1 > 0 && s2 < 0)) {
+                T d{det2(line.a, line.b, l.a, l.b)};
+                if (d != 0) {
+                    result.x = -det(line.c, line.b, l.c, l.b) / d;
+                    result.y = -det(line.a, line.c, l.a, l.c) / d;
+                }
+                if (d == 0 || !contains(result))
+                    result = point_between(s1, s2);
+                clamp(result);
+                return true;
+            }
+
+            T tolerance{Traits::eps * Traits::eps * line.square_length()};
+            if (s1 * s1 <= tolerance || s2 * s2 <= tolerance) {
+                result = s1 * s1 <= s2 * s2 ? l.p1 : l.p2;
+                return true;
+            }
+
+            return false;
+        }
 
         /**
          * @brief Returns whether the the segments intersect and
@@ -193,20 +438,99 @@ class Segment {
          * 
          * @return If the line and the segment intersect
         */
-        bool cross_line(const Segment &seg, Point &result) const;
-
-        bool operator==(const Segment &other) const;
-        Segment &operator=(const Segment &other);
+        constexpr bool cross_line(const Segment &seg, Point &result) const {
+            using namespace poly_private;
+
+            // Segments whose boxes are apart can not meet
+            const Point &q1{seg.l.p1};
+            const Point &q2{seg.l.p2};
+            if (maximum(l.p1.x, l.p2.x) + Traits::eps < minimum(q1.x, q2.x) ||
+                maximum(q1.x, q2.x) + Traits::eps < minimum(l.p1.x, l.p2.x) ||
+                maximum(l.p1.y, l.p2.y) + Traits::eps < minimum(q1.y, q2.y) ||
+                maximum(q1.y, q2.y) + Traits::eps < minimum(l.p1.y, l.p2.y))
+                return false;
+
+            // The sides of the four ends decide the crossing exactly
+            T s1{orient2d(q1.x, q1.y, q2.x, q2.y, l.p1.x, l.p1.y)};
+            T s2{orient2d(q1.x, q1.y, q2.x, q2.y, l.p2.x, l.p2.y)};
+            T s3{orient2d(l.p1.x, l.p1.y, l.p2.x, l.p2.y, q1.x, q1.y)};
+            T s4{orient2d(l.p1.x, l.p1.y, l.p2.x, l.p2.y, q2.x, q2.y)};
+
+            // Collinear segments have no single point of intersection
+            if ((s1 == 0 && s2 == 0) || (s3 == 0 && s4 == 0))
+                return false;
+
+            if (((s1 < 0 && s2 > 0) || (s1 > 0 && s2 < 0)) && ((s3 < 0 && s4 > 0) || (s3 > 0 && s4 < 0))) {
+                // The rounded coefficients of nearly parallel segments can
+                // put the point far away, then it is taken from the sides
+                T d{det2(l.a, l.b, seg.l.a, seg.l.b)};
+                if (d != 0) {
+                    result.x = -det(l.c, l.b, seg.l.c, seg.l.b) / d;
+                    result.y = -det(l.a, l.c, seg.l.a, seg.l.c) / d;
+                }
+                if (d == 0 || !contains(result) || !seg.contains(result))
+                    result = point_between(s1, s2);
+                clamp(result);
+                seg.clamp(result);
+                return true;
+            }
+
+            // Otherwise they only meet where an end touches the other
+            // segment, up to the tolerance
+            if (seg.touches(l.p1, s1)) {
+                result = l.p1;
+            } else if (seg.touches(l.p2, s2)) {
+                result = l.p2;
+            } else if (touches(q1, s3)) {
+                result = q1;
+            } else if (touches(q2, s4)) {
+                result = q2;
+            } else {
+                return false;
+            }
+
+            return true;
+        }
+
+        constexpr bool operator==(const Segment &other) const {
+            return l.p1 == other.l.p1 and l.p2 == other.l.p2;
+        }
 
         /**
          * @brief Returns the bisector between the two lines
         */
-        static Line get_bisector(const Segment &s1, const Segment &s2);
+        static Line get_bisector(const Segment &seg1, const Segment &seg2) {
+            return get_bisector(seg1, seg1.norm(), seg2, seg2.norm());
+        }
 
         /**
-         * @brief Returns the tangent of the angle between the two lines in radians
+         * @brief Same as get_bisector with the norms of the segments
+         * already known, like the ones kept for the edges of a ring
         */
-        static double get_tan_angle(const Segment &s1, const Segment &s2);
+        static Line get_bisector(const Segment &seg1, T q1, const Segment &seg2, T q2) {
+            if (seg1 == seg2) {
+                return seg1.make_line();
+            } else {
+                T a{seg1.l.a / q1 - seg2.l.a / q2};
+                T b{seg1.l.b / q1 - seg2.l.b / q2};
+                T c{seg1.l.c / q1 - seg2.l.c / q2};
+
+                return Line{a, b, c};
+            }
+        }
 
-        friend std::ostream &operator<<(std::ostream &out, const Segment &s);
+        /**
+         * @brief Returns the tangent of the angle between the two lines in radians
+        */
+        static constexpr T get_tan_angle(const Segment &s1, const Segment &s2) {
+            return Line::get_tan_angle(s1.l, s2.l);
+        }
+
+        friend std::ostream &operator<<(std::ostream &out, const Segment &s) {
+            out << s.l;
+            return out;
+        }
 };
+
+using Line = BasicLine<double>;
+using Segment = BasicSegment<double>;
@@ -1,6 +1,5 @@
 /**
  * The MIT License (MIT)
- * Copyright (c) 2016 Grabarchuk Viktor
  * Copyright (c) 2023 Pablo López Sedeño
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the “Software”), to deal
@@ -21,35 +20,172 @@
 
 #pragma once
 
+#include <cmath>
+#include <cstdint>
 #include <ostream>
+#include <string>
+#include <type_traits>
 #include <vector>
 #include <limits>
 
-const double POLY_SPLIT_EPS = 1E-6;
-
-struct Point {
-    double x, y;
-
-    Point(double x = 0.0f, double y = 0.0f) : x(x), y(y) {};
-
-    Point operator-() const;
-    Point &operator+=(const Point &p);
-    Point &operator-=(const Point &p);
-    Point &operator*=(double p);
-    Point &operator/=(double p);
-    Point operator-(const Point &p) const;
-    Point operator+(const Point &p) const;
-    Point operator*(const double p) const;
-    Point operator/(const double p) const;
-    bool operator==(const Point &p) const;
-    bool operator!=(const Point &p) const;
-    operator std::string() const;
-    double distance(const Point &p) const;
-    double square_distance(const Point &p) const;
-    Point abs() const;
-    friend std::ostream& operator<<(std::ostream &out, const Point &v);
+constexpr double POLY_SPLIT_EPS = 1E-6;
+
+/**
+ * @brief Properties of the coordinate types. Real is the type of the
+ * lengths and areas, eps is the tolerance of the comparisons and
+ * convert rounds any other coordinate to this type.
+*/
+template <typename T>
+struct ScalarTraits;
+
+template <>
+struct ScalarTraits<double> {
+    using Real = double;
+    static constexpr double eps{POLY_SPLIT_EPS};
+
+    template <typename U>
+    static constexpr double convert(U v) {
+        return static_cast<double>(v);
+    }
+};
+
+template <>
+struct ScalarTraits<float> {
+    using Real = float;
+    static constexpr float eps{1E-4f};
+
+    template <typename U>
+    static constexpr float convert(U v) {
+        return static_cast<float>(v);
+    }
+};
+
+/**
+ * @brief Coordinates snapped to an integer grid, which are compared
+ * exactly.
+*/
+template <>
+struct ScalarTraits<int64_t> {
+    using Real = double;
+    static constexpr int64_t eps{0};
+
+    template <typename U>
+    static int64_t convert(U v) {
+        if constexpr (std::is_integral_v<U>)
+            return static_cast<int64_t>(v);
+        else
+            return static_cast<int64_t>(std::llround(v));
+    }
+};
+
+namespace poly_private {
+/**
+ * @brief Same as fabs, which is not constexpr.
+*/
+template <typename T>
+constexpr T abs(T v) {
+    return v < 0 ? -v : v;
+}
+};
+
+template <typename T>
+struct BasicPoint {
+    using Traits = ScalarTraits<T>;
+    using Real = typename Traits::Real;
+
+    T x, y;
+
+    constexpr BasicPoint(T x = T{}, T y = T{}) : x(x), y(y) {};
+
+    /**
+     * @brief Converts the coordinates of another type, rounding them
+     * when this one is coarser.
+    */
+    template <typename U, typename = std::enable_if_t<!std::is_same_v<T, U>>>
+    explicit constexpr BasicPoint(const BasicPoint<U> &p) : x{Traits::convert(p.x)}, y{Traits::convert(p.y)} {}
+
+    constexpr BasicPoint operator-() const {
+        return BasicPoint{-x, -y};
+    }
+
+    constexpr BasicPoint &operator+=(const BasicPoint &p) {
+        x += p.x;
+        y += p.y;
+
+        return *this;
+    }
+
+    constexpr BasicPoint &operator-=(const BasicPoint &p) {
+        x -= p.x;
+        y -= p.y;
+
+        return *this;
+    }
+
+    constexpr BasicPoint &operator*=(T p) {
+        x *= p;
+        y *= p;
+
+        return *this;
+    }
+
+    constexpr BasicPoint &operator/=(T p) {
+        x /= p;
+        y /= p;
+
+        return *this;
+    }
+
+    constexpr BasicPoint operator-(const BasicPoint &p) const {
+        return BasicPoint{x - p.x, y - p.y};
+    }
+
+    constexpr BasicPoint operator+(const BasicPoint &p) const {
+        return BasicPoint{x + p.x, y + p.y};
+    }
+
+    constexpr BasicPoint operator*(const T p) const {
+        return BasicPoint{x * p, y * p};
+    }
+
+    constexpr BasicPoint operator/(const T p) const {
+        return BasicPoint{x / p, y / p};
+    }
+
+    constexpr bool operator==(const BasicPoint &p) const {
+        return poly_private::abs(x - p.x) <= Traits::eps && poly_private::abs(y - p.y) <= Traits::eps;
+    }
+
+    constexpr bool operator!=(const BasicPoint &p) const {
+        return poly_private::abs(x - p.x) > Traits::eps || poly_private::abs(y - p.y) > Traits::eps;
+    }
+
+    operator std::string() const {
+        return "(" + std::to_string(x) + ", " + std::to_string(y) + ")";
+    }
+
+    Real distance(const BasicPoint &p) const {
+        return std::sqrt(square_distance(p));
+    }
+
+    constexpr Real square_distance(const BasicPoint &p) const {
+        Real dx = static_cast<Real>(x - p.x);
+        Real dy = static_cast<Real>(y - p.y);
+
+        return dx * dx + dy * dy;
+    }
+
+    constexpr BasicPoint abs() const {
+        return BasicPoint{poly_private::abs(x), poly_private::abs(y)};
+    }
+
+    friend std::ostream& operator<<(std::ostream &out, const BasicPoint &v) {
+        out << "(" << v.x << ", " << v.y << ")";
+        return out;
+    }
 };
 
+using Point = BasicPoint<double>;
 using Points = std::vector<Point>;
 using PointIter = std::vector<Point>::iterator;
-using CPointIter = std::vector<Point>::const_iterator;
\ No newline at end of file
+using CPointIter = std::vector<Point>::const_iterator;
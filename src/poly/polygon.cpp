@@ -20,16 +20,168 @@
 */
 
 #include "polygon.hpp"
+#include "edge_grid.hpp"
+#include "split_stats.hpp"
+#include "split_trace.hpp"
+#include "split_workspace.hpp"
+#include "thread_pool.hpp"
+#include "vertex_array.hpp"
 
 #include <cfloat>
 #include <algorithm>
+#include <chrono>
 #include <exception>
+#include <functional>
+#include <mutex>
 #include <cmath>
+#include <optional>
 
 using namespace poly_private;
 
-Polygons::Polygons(const Segment &s1, const Segment &s2) {
-    bisector = Segment::get_bisector(s1, s2);
+#ifdef POLY_SPLIT_STATS
+thread_local SplitStats poly_private::split_counters;
+#endif
+
+namespace {
+/**
+ * @brief Returns the index, in the vertices as they were passed, of the
+ * edge k of their clockwise copy.
+*/
+size_t original_edge(size_t k, size_t n, bool reversed) {
+    return reversed ? (2 * n - 2 - k) % n : k;
+}
+
+/**
+ * @brief Adds to the stats the counts of the calling thread while it
+ * exists. Several threads can add to the same stats.
+*/
+class CountScope {
+#ifdef POLY_SPLIT_STATS
+    private:
+        SplitStats *stats;
+        std::mutex &mutex;
+        SplitStats saved;
+
+    public:
+        CountScope(SplitStats *stats, std::mutex &mutex) : stats{stats}, mutex{mutex}, saved{split_counters} {
+            split_counters = SplitStats{};
+        }
+
+        ~CountScope() {
+            SplitStats counted{split_counters};
+            split_counters = saved;
+            split_counters += counted;
+            if (stats != nullptr) {
+                std::lock_guard<std::mutex> lock{mutex};
+                *stats += counted;
+            }
+        }
+#else
+    public:
+        CountScope(SplitStats *, std::mutex &) {}
+#endif
+};
+
+/**
+ * @brief Adds to a phase of the stats the time since the last mark.
+*/
+class PhaseTimer {
+#ifdef POLY_SPLIT_STATS
+    private:
+        SplitStats *stats;
+        std::chrono::steady_clock::time_point last{std::chrono::steady_clock::now()};
+
+    public:
+        explicit PhaseTimer(SplitStats *stats) : stats{stats} {}
+
+        bool enabled(void) const {
+            return stats != nullptr;
+        }
+
+        void mark(double SplitStats::*phase) {
+            auto now{std::chrono::steady_clock::now()};
+            if (stats != nullptr)
+                stats->*phase += std::chrono::duration<double>(now - last).count();
+            last = now;
+        }
+#else
+    public:
+        explicit PhaseTimer(SplitStats *) {}
+
+        constexpr bool enabled(void) const {
+            return false;
+        }
+
+        void mark(double SplitStats::*) {}
+#endif
+};
+};
+
+const char *split_status_message(SplitStatus status) {
+    switch (status) {
+        case SplitStatus::Ok:
+            return "";
+        case SplitStatus::NotEnoughPoints:
+            return "The polygon has not enough vertices";
+        case SplitStatus::AreaTooBig:
+            return "The required area is too big";
+        case SplitStatus::NoCut:
+            return "The cut line does not exists";
+    }
+
+    return "";
+}
+
+AreaTable::AreaTable(const Points &vertices) {
+    assign(vertices);
+}
+
+void AreaTable::assign(const Points &vertices) {
+    size_t n{vertices.size()};
+    Point origin{n > 0 ? vertices[0] : Point{}};
+
+    ring.clear();
+    prefix.clear();
+    ring.reserve(n);
+    for (const Point &v : vertices) {
+        ring.push_back(v - origin);
+    }
+
+    prefix.reserve(n + 1);
+    prefix.push_back(0);
+    for (size_t i = 0; i < n; i++) {
+        const Point &a{ring[i]};
+        const Point &b{ring[i + 1 < n ? i + 1 : 0]};
+        prefix.push_back(prefix.back() + (a.x * b.y - b.x * a.y));
+    }
+}
+
+double AreaTable::count_square_signed(size_t first, size_t count) const {
+    size_t n{ring.size()};
+    if (count < 3 || count > n) {
+        return 0;
+    }
+
+    size_t last{(first + count - 1) % n};
+
+    double chain;
+    if (first <= last)
+        chain = prefix[last] - prefix[first];
+    else
+        chain = prefix[n] - prefix[first] + prefix[last];
+
+    const Point &a{ring[last]};
+    const Point &b{ring[first]};
+    double closing{a.x * b.y - b.x * a.y};
+
+    return -(chain + closing) / 2.0;
+}
+
+Polygons::Polygons(const Segment &s1, const Segment &s2) : Polygons{s1, s1.norm(), s2, s2.norm()} {}
+
+Polygons::Polygons(const Segment &s1, double norm1, const Segment &s2, double norm2) {
+    POLY_SPLIT_TRACE_SCOPE("Polygons");
+    bisector = Segment::get_bisector(s1, norm1, s2, norm2);
 
     Point p1{s1.get_start()};
     Point p2{s1.get_end()};
@@ -109,7 +261,103 @@ Polygons::Polygons(const Segment &s1, const Segment &s2) {
     total_square = left_triangle_square + trapezoid_square + right_triangle_square;
 }
 
+EdgeBlocks::EdgeBlocks(const Points &vertices) {
+    assign(vertices);
+}
+
+void EdgeBlocks::assign(const Points &vertices) {
+    ring = vertices;
+    min.clear();
+    max.clear();
+
+    size_t n{ring.size()};
+    for (size_t first = 0; first < n; first += size) {
+        Point lo{ring[first]};
+        Point hi{ring[first]};
+        for (size_t i = first; i < std::min(first + size, n); i++) {
+            const Point &p{ring[i + 1 < n ? i + 1 : 0]};
+            lo = Point{std::min(lo.x, p.x), std::min(lo.y, p.y)};
+            hi = Point{std::max(hi.x, p.x), std::max(hi.y, p.y)};
+        }
+
+        min.push_back(lo);
+        max.push_back(hi);
+    }
+}
+
+double EdgeBlocks::min_sq_length(size_t edge, size_t block) const {
+    const Point &p1{ring[edge]};
+    const Point &p2{ring[edge + 1 < ring.size() ? edge + 1 : 0]};
+
+    // Distance between the box of the edge and the box of the block
+    double dx{std::max({0.0, min[block].x - std::max(p1.x, p2.x), std::min(p1.x, p2.x) - max[block].x})};
+    double dy{std::max({0.0, min[block].y - std::max(p1.y, p2.y), std::min(p1.y, p2.y) - max[block].y})};
+    double distance{std::max(0.0, sqrt(dx * dx + dy * dy) - 4.0 * POLY_SPLIT_EPS)};
+
+    return distance * distance;
+}
+
+double Polygons::max_total_square(const Segment &s1, const Segment &s2) {
+    const Point p[4]{s1.get_start(), s1.get_end(), s2.get_start(), s2.get_end()};
+
+    auto cross = [](const Point &u, const Point &v) {
+        return u.x * v.y - v.x * u.y;
+    };
+
+    // The convex hull of four points is the biggest of the triangles
+    // and quadrilaterals they form
+    double hull{0};
+    for (int k = 0; k < 4; k++) {
+        const Point &a{p[(k + 1) % 4]};
+        const Point &b{p[(k + 2) % 4]};
+        const Point &c{p[(k + 3) % 4]};
+        hull = std::max(hull, fabs(cross(b - a, c - a)));
+    }
+    hull = std::max(hull, fabs(cross(p[2] - p[0], p[3] - p[1])));
+    hull = std::max(hull, fabs(cross(p[1] - p[0], p[3] - p[2])));
+    hull = std::max(hull, fabs(cross(p[3] - p[0], p[2] - p[1])));
+    hull /= 2.0;
+
+    // The pieces lie on s1 and s2 up to the tolerance of cross_line
+    double w{std::max({p[0].x, p[1].x, p[2].x, p[3].x}) - std::min({p[0].x, p[1].x, p[2].x, p[3].x})};
+    double h{std::max({p[0].y, p[1].y, p[2].y, p[3].y}) - std::min({p[0].y, p[1].y, p[2].y, p[3].y})};
+    double margin{4.0 * POLY_SPLIT_EPS * (w + h + POLY_SPLIT_EPS)};
+
+    // There are at most three pieces, each one inside the hull
+    return 3.0 * (hull + margin) * (1.0 + 1E-9);
+}
+
+double Polygons::min_sq_length(const Segment &s1, const Segment &s2) {
+    const Point a{s1.get_start()};
+    const Point b{s1.get_end()};
+    const Point c{s2.get_start()};
+    const Point d{s2.get_end()};
+
+    auto cross = [](const Point &u, const Point &v) {
+        return u.x * v.y - v.x * u.y;
+    };
+
+    // Touching or crossing segments, including the collinear ones
+    if (cross(b - a, c - a) * cross(b - a, d - a) <= 0 &&
+        cross(d - c, a - c) * cross(d - c, b - c) <= 0) {
+        return 0;
+    }
+
+    auto distance = [](const Point &p, const Point &start, const Point &end) {
+        Point dir{end - start};
+        double l{dir.x * dir.x + dir.y * dir.y};
+        double t{l > 0 ? std::clamp(((p.x - start.x) * dir.x + (p.y - start.y) * dir.y) / l, 0.0, 1.0) : 0.0};
+        return p.distance(start + dir * t);
+    };
+
+    double min{std::min({distance(a, c, d), distance(b, c, d), distance(c, a, b), distance(d, a, b)})};
+    min = std::max(0.0, min - 4.0 * POLY_SPLIT_EPS);
+
+    return min * min;
+}
+
 bool Polygons::find_cut_line(double square, Segment &cut_line) {
+    POLY_SPLIT_TRACE_SCOPE("find_cut_line");
     if (square > total_square) {
         return false;
     }
@@ -124,7 +372,7 @@ bool Polygons::find_cut_line(double square, Segment &cut_line) {
             cut_line = Segment{left_triangle[0], p};
             return true;
         }
-    } else if(left_triangle_square < square && square < (left_triangle_square + trapezoid_square)) {
+    } else if(left_triangle_square <= square && square <= (left_triangle_square + trapezoid_square)) {
         Segment t{trapezoid[0], trapezoid[3]};
         double tgA{Segment::get_tan_angle(t, bisector)};
         double S{square - left_triangle_square};
@@ -139,6 +387,15 @@ bool Polygons::find_cut_line(double square, Segment &cut_line) {
         } else {
             m = S / trapezoid_square;
         }
+
+        // The formula is exact for a trapezoid, but the piece may be any
+        // quadrilateral between the edges, and then the cut can fall off
+        // their ends. Such a cut does not join the edges, and the bound of
+        // min_sq_length does not hold for it.
+        if (!(m >= 0 && m <= 1)) {
+            return false;
+        }
+
         Point p{trapezoid[0] + (trapezoid[3] - trapezoid[0]) * m};
         Point pp{trapezoid[1] + (trapezoid[2] - trapezoid[1]) * m};
 
@@ -189,44 +446,92 @@ const char *Polygon::CannotSplitException::what() const noexcept {
     return message.c_str();
 }
 
-Polygon::Polygon() {}
+Polygon::BasicPolygon() {}
 
-Polygon::Polygon(const Polygon &p) {
+Polygon::BasicPolygon(const Polygon &p) {
     vertices = p.vertices;
 }
 
-Polygon::Polygon(const Points &p) {
+Polygon::BasicPolygon(const Points &p) {
     vertices = p;
 }
 
-double Polygon::count_square_signed(void) const {
-    size_t pointsCount{vertices.size()};
+Polygon::BasicPolygon(const PolygonView &view) {
+    vertices.assign(view.begin(), view.end());
+}
+
+double PolygonView::count_square_signed(void) const {
+    size_t pointsCount{vertex_count};
     if (pointsCount < 3) {
         return 0;
     }
 
-    double result{0};
-    for (size_t i = 0; i < pointsCount; i++) {
-        if (i == 0)
-            result += vertices[i].x * (vertices[pointsCount - 1].y - vertices[i + 1].y);
-        else if (i == pointsCount - 1)
-            result += vertices[i].x * (vertices[i - 1].y - vertices[0].y);
-        else
-            result += vertices[i].x * (vertices[i - 1].y - vertices[i + 1].y);
+    // The first and the last vertices wrap around, the rest of the loop
+    // has no branches
+    size_t last{pointsCount - 1};
+    double result{vertices[0].x * (vertices[last].y - vertices[1].y)};
+    for (size_t i = 1; i < last; i++) {
+        result += vertices[i].x * (vertices[i - 1].y - vertices[i + 1].y);
     }
+    result += vertices[last].x * (vertices[last - 1].y - vertices[0].y);
 
     return result / 2.0;
 }
 
-double Polygon::count_square() const {
+double PolygonView::count_square() const {
     return fabs(count_square_signed());
 }
 
-void Polygon::split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line) const {
-    int polygon_size{static_cast<int>(vertices.size())};
+void PolygonView::split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                        const SplitOptions &options) const {
+    SplitWorkspace workspace;
+    split(square, poly1, poly2, cut_line, workspace, options);
+}
+
+void PolygonView::split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                        SplitWorkspace &workspace, const SplitOptions &options) const {
+    size_t start_edge;
+    size_t end_edge;
+    SplitStatus status{find_split(square, poly1, poly2, cut_line, start_edge, end_edge, workspace, options)};
+    if (status == SplitStatus::NotEnoughPoints)
+        throw Polygon::NotEnoughPointsException{split_status_message(status)};
+    if (status != SplitStatus::Ok)
+        throw Polygon::CannotSplitException{split_status_message(status)};
+}
+
+SplitResult PolygonView::try_split(double square, const SplitOptions &options) const {
+    SplitResult result;
+    SplitWorkspace workspace;
+    try_split(square, result, workspace, options);
+    return result;
+}
+
+void PolygonView::try_split(double square, SplitResult &result, SplitWorkspace &workspace,
+                            const SplitOptions &options) const {
+    result.status = find_split(square, result.poly1, result.poly2, result.cut_line,
+                               result.start_edge, result.end_edge, workspace, options);
+    result.exists = result.status == SplitStatus::Ok;
+    if (result.status == SplitStatus::NotEnoughPoints) {
+        result.poly1.clear();
+        result.poly2.clear();
+    }
+}
 
-    Points polygon{vertices};
-    if (!is_clockwise()) {
+SplitStatus PolygonView::find_split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                                    size_t &start_edge, size_t &end_edge, SplitWorkspace &workspace,
+                                    const SplitOptions &options) const {
+    if (vertex_count < 2)
+        return SplitStatus::NotEnoughPoints;
+
+    POLY_SPLIT_TRACE_SCOPE("prepare");
+    PhaseTimer timer{options.stats};
+    size_t memory{timer.enabled() ? workspace.memory() : 0};
+    int polygon_size{static_cast<int>(vertex_count)};
+
+    Points &polygon{workspace.polygon};
+    polygon.assign(vertices, vertices + vertex_count);
+    bool reversed{!is_clockwise()};
+    if (reversed) {
         std::reverse(polygon.begin(), polygon.end());
     }
 
@@ -234,64 +539,182 @@ void Polygon::split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_
     poly2.clear();
 
     if (count_square() - square <= POLY_SPLIT_EPS) {
-        poly1 = *this;
-        throw Polygon::CannotSplitException{"The required area is too big"};
+        poly1.vertices.assign(vertices, vertices + vertex_count);
+        timer.mark(&SplitStats::prepare_seconds);
+        return SplitStatus::AreaTooBig;
     }
 
-    bool min_cut_line_exists{false};
-    double min_sq_length = DBL_MAX;
+    AreaTable &areas{workspace.areas};
+    EdgeBlocks &blocks{workspace.blocks};
+    EdgeGrid &edges{workspace.edges};
+    areas.assign(polygon);
+    blocks.assign(polygon);
+    edges.assign(polygon);
+    std::atomic<double> min_sq_length{DBL_MAX};
+
+    // The areas around the pairs of a convex polygon grow with the
+    // edges, so only a few pairs of every row can have the cut. The
+    // margin covers the tolerance of the cut end points.
+    bool convex{is_convex()};
+    double margin{0};
+    if (convex) {
+        auto [min_x, max_x] = std::minmax_element(polygon.begin(), polygon.end(),
+                                                  [](const Point &a, const Point &b) { return a.x < b.x; });
+        auto [min_y, max_y] = std::minmax_element(polygon.begin(), polygon.end(),
+                                                  [](const Point &a, const Point &b) { return a.y < b.y; });
+        double w{max_x->x - min_x->x};
+        double h{max_y->y - min_y->y};
+        margin = 1E-9 * count_square() + 4.0 * POLY_SPLIT_EPS * (w + h + POLY_SPLIT_EPS);
+    }
 
-    for (int i = 0; i < polygon_size - 1; i++) {
-        for (int j = i + 1; j < polygon_size; j++) {
-            Polygon p1;
-            Polygon p2;
+    // Every row keeps its own best cut, so the result does not depend
+    // on the order in which the rows are searched
+    std::vector<SplitCandidate> &rows{workspace.rows};
+    rows.assign(polygon_size > 1 ? polygon_size - 1 : 0, SplitCandidate{});
+    if (timer.enabled())
+        options.stats->allocated_bytes += workspace.memory() - memory;
+    timer.mark(&SplitStats::prepare_seconds);
+    POLY_SPLIT_TRACE_NEXT("search");
+
+    std::mutex stats_mutex;
+    auto search{[&](size_t i) {
+        CountScope count{options.stats, stats_mutex};
+        if (convex) {
+            Polygon::split_convex_row(static_cast<int>(i), polygon, areas, edges, square, margin, min_sq_length, rows[i]);
+        } else {
+            Polygon::split_row(static_cast<int>(i), polygon, areas, blocks, edges, square, min_sq_length, rows[i]);
+        }
+    }};
 
-            p1.clear();
-            p2.clear();
-            
-            int pc1{j - i};
-            for (int z = 1; z <= pc1; ++z) {
-                p1.push_back(polygon[z + i]);
-            }
+    if (options.pool != nullptr) {
+        // Passed by reference, so that std::function does not copy it
+        options.pool->run(rows.size(), std::ref(search));
+    } else {
+        for (size_t i = 0; i < rows.size(); i++) {
+            search(i);
+        }
+    }
 
-            int pc2{polygon_size - pc1};
-            for (int z = 1; z <= pc2; ++z) {
-                p2.push_back(polygon[(z + j) % polygon_size]);
-            }
+    SplitCandidate best;
+    for (const SplitCandidate &row : rows) {
+        if (row.exists && row.sq_length < best.sq_length) {
+            best = row;
+        }
+    }
 
-            Line l1{polygon[i], polygon[i + 1]};
-            Line l2{polygon[j], polygon[(j + 1) < polygon_size ? (j + 1) : 0]};
-            Segment cut;
+    timer.mark(&SplitStats::search_seconds);
 
-            if (get_cut(l1, l2, square, p1, p2, cut)) {
-                double sq_length{cut.square_length()};
+    if (!best.exists) {
+        poly1.vertices = polygon;
+        return SplitStatus::NoCut;
+    }
 
-                if (sq_length < min_sq_length && is_segment_inside(cut, i, j)) {
-                    min_sq_length = sq_length;
-                    poly1 = p1;
-                    poly2 = p2;
-                    cut_line = cut;
-                    min_cut_line_exists = true;
-                }
-            }
+    POLY_SPLIT_TRACE_NEXT("parts");
+    Polygon::split_parts(polygon, best, poly1, poly2, cut_line);
+    timer.mark(&SplitStats::parts_seconds);
+    start_edge = original_edge(best.j, vertex_count, reversed);
+    end_edge = original_edge(best.i, vertex_count, reversed);
+    return SplitStatus::Ok;
+}
+
+std::vector<SplitResult> PolygonView::split_many(const double *squares, size_t count,
+                                                 const SplitOptions &options) const {
+    std::vector<SplitResult> results(count);
+    if (count == 0)
+        return results;
+
+    POLY_SPLIT_TRACE_SCOPE("prepare");
+    PhaseTimer timer{options.stats};
+    int polygon_size{static_cast<int>(vertex_count)};
+
+    Points polygon{vertices, vertices + vertex_count};
+    bool reversed{!is_clockwise()};
+    if (reversed) {
+        std::reverse(polygon.begin(), polygon.end());
+    }
+
+    // Only the areas that fit are searched
+    double total{count_square()};
+    std::vector<size_t> wanted;
+    std::vector<double> targets;
+    for (size_t k = 0; k < count; k++) {
+        if (total - squares[k] <= POLY_SPLIT_EPS) {
+            results[k].status = SplitStatus::AreaTooBig;
+            results[k].poly1 = Polygon{*this};
+        } else {
+            wanted.push_back(k);
+            targets.push_back(squares[k]);
         }
     }
 
-    if (min_cut_line_exists) {
-        poly1.push_back(cut_line.get_start());
-        poly1.push_back(cut_line.get_end());
+    if (targets.empty())
+        return results;
+
+    AreaTable areas{polygon};
+    EdgeBlocks blocks{polygon};
+    EdgeGrid edges{polygon};
+    std::vector<std::atomic<double>> min_sq_lengths(targets.size());
+    for (std::atomic<double> &bound : min_sq_lengths) {
+        bound.store(DBL_MAX, std::memory_order_relaxed);
+    }
 
-        poly2.push_back(cut_line.get_end());
-        poly2.push_back(cut_line.get_start());
+    // The best cut of every row and area, as in split
+    size_t rows{polygon_size > 1 ? static_cast<size_t>(polygon_size - 1) : 0};
+    std::vector<SplitCandidate> candidates(rows * targets.size());
+    timer.mark(&SplitStats::prepare_seconds);
+    POLY_SPLIT_TRACE_NEXT("search");
+
+    std::mutex stats_mutex;
+    auto search{[&](size_t i) {
+        CountScope count{options.stats, stats_mutex};
+        Polygon::split_many_row(static_cast<int>(i), polygon, areas, blocks, edges, targets,
+                                min_sq_lengths.data(), candidates.data() + i * targets.size());
+    }};
+
+    if (options.pool != nullptr) {
+        options.pool->run(rows, search);
     } else {
-        poly1 = Polygon{polygon};
-        throw Polygon::CannotSplitException{"The cut line does not exists"};
+        for (size_t i = 0; i < rows; i++) {
+            search(i);
+        }
+    }
+    timer.mark(&SplitStats::search_seconds);
+    POLY_SPLIT_TRACE_NEXT("parts");
+
+    for (size_t k = 0; k < targets.size(); k++) {
+        SplitCandidate best;
+        for (size_t i = 0; i < rows; i++) {
+            const SplitCandidate &row{candidates[i * targets.size() + k]};
+            if (row.exists && row.sq_length < best.sq_length) {
+                best = row;
+            }
+        }
+
+        SplitResult &result{results[wanted[k]]};
+        if (best.exists) {
+            result.status = SplitStatus::Ok;
+            result.exists = true;
+            Polygon::split_parts(polygon, best, result.poly1, result.poly2, result.cut_line);
+            result.start_edge = original_edge(best.j, vertex_count, reversed);
+            result.end_edge = original_edge(best.i, vertex_count, reversed);
+        } else {
+            result.status = SplitStatus::NoCut;
+            result.poly1 = Polygon{polygon};
+        }
     }
+    timer.mark(&SplitStats::parts_seconds);
+
+    return results;
 }
 
-double Polygon::find_distance(const Point &point) const {
+std::vector<SplitResult> PolygonView::split_many(const std::vector<double> &squares,
+                                                 const SplitOptions &options) const {
+    return split_many(squares.data(), squares.size(), options);
+}
+
+double PolygonView::find_distance(const Point &point) const {
     double distance{std::numeric_limits<double>::infinity()};
-    int poly_size{static_cast<int>(vertices.size())};
+    int poly_size{static_cast<int>(vertex_count)};
     if (poly_size < 2)
         throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
 
@@ -312,6 +735,377 @@ double Polygon::find_distance(const Point &point) const {
     return distance;
 }
 
+bool PolygonView::is_point_inside(const Point &point) const {
+    int pointsCount{static_cast<int>(vertex_count) - 1};
+    if (pointsCount < 2)
+        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+
+    Segment s{Line{point, Vector{0.0, 1e100}}};
+    int result{0};
+    Point p;
+    for (int i = 0; i < pointsCount; i++) {
+        Segment seg{vertices[i], vertices[i + 1]};
+        result += s.cross_line(seg, p);
+    }
+    Segment seg{vertices[pointsCount], vertices[0]};
+    result += s.cross_line(seg, p);
+    return result % 2 != 0;
+}
+
+bool PolygonView::is_clockwise() const {
+    if (vertex_count < 2)
+        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+
+    double sum{0};
+    int t{static_cast<int>(vertex_count) - 1};
+    for (int i = 0; i < t; i++) {
+        sum += (vertices[i + 1].x - vertices[i].x) * (vertices[i + 1].y + vertices[i].y);
+    }
+    sum += (vertices[0].x - vertices[t].x) * (vertices[0].y + vertices[t].y);
+    return sum <= 0;
+}
+
+bool PolygonView::is_convex() const {
+    size_t n{vertex_count};
+    if (n < 3)
+        return false;
+
+    // Sign of the last edge that moves along each axis
+    auto sign{[](double d) { return (d > 0) - (d < 0); }};
+    int last_dx{0};
+    int last_dy{0};
+    for (size_t i = 0; i < n; i++) {
+        const Point &a{vertices[i]};
+        const Point &b{vertices[i + 1 < n ? i + 1 : 0]};
+        last_dx = sign(b.x - a.x) != 0 ? sign(b.x - a.x) : last_dx;
+        last_dy = sign(b.y - a.y) != 0 ? sign(b.y - a.y) : last_dy;
+    }
+
+    // All the turns go the same way, and the edges go around once, so
+    // they change their direction along each axis twice at most
+    int turn{0};
+    int x_changes{0};
+    int y_changes{0};
+    for (size_t i = 0; i < n; i++) {
+        const Point &a{vertices[i]};
+        const Point &b{vertices[(i + 1) % n]};
+        const Point &c{vertices[(i + 2) % n]};
+
+        int t{sign(orient2d(a.x, a.y, b.x, b.y, c.x, c.y))};
+        if (t != 0) {
+            if (turn != 0 && t != turn)
+                return false;
+            turn = t;
+        }
+
+        int dx{sign(b.x - a.x)};
+        if (dx != 0) {
+            x_changes += dx != last_dx;
+            last_dx = dx;
+        }
+
+        int dy{sign(b.y - a.y)};
+        if (dy != 0) {
+            y_changes += dy != last_dy;
+            last_dy = dy;
+        }
+    }
+
+    return turn != 0 && x_changes <= 2 && y_changes <= 2;
+}
+
+double Polygon::count_square_signed(void) const {
+    return view().count_square_signed();
+}
+
+double Polygon::count_square() const {
+    return view().count_square();
+}
+
+void Polygon::split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                    const SplitOptions &options) const {
+    view().split(square, poly1, poly2, cut_line, options);
+}
+
+void Polygon::split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                    SplitWorkspace &workspace, const SplitOptions &options) const {
+    view().split(square, poly1, poly2, cut_line, workspace, options);
+}
+
+SplitResult Polygon::try_split(double square, const SplitOptions &options) const {
+    return view().try_split(square, options);
+}
+
+void Polygon::try_split(double square, SplitResult &result, SplitWorkspace &workspace,
+                        const SplitOptions &options) const {
+    view().try_split(square, result, workspace, options);
+}
+
+void Polygon::split_parts(const Points &polygon, const SplitCandidate &best,
+                          Polygon &poly1, Polygon &poly2, Segment &cut_line) {
+    int polygon_size{static_cast<int>(polygon.size())};
+
+    cut_line = best.cut;
+
+    int pc1{best.j - best.i};
+    for (int z = 1; z <= pc1; ++z) {
+        poly1.push_back(polygon[z + best.i]);
+    }
+
+    int pc2{polygon_size - pc1};
+    for (int z = 1; z <= pc2; ++z) {
+        poly2.push_back(polygon[(z + best.j) % polygon_size]);
+    }
+
+    poly1.push_back(cut_line.get_start());
+    poly1.push_back(cut_line.get_end());
+
+    poly2.push_back(cut_line.get_end());
+    poly2.push_back(cut_line.get_start());
+}
+
+std::vector<SplitResult> Polygon::split_many(const double *squares, size_t count,
+                                             const SplitOptions &options) const {
+    return view().split_many(squares, count, options);
+}
+
+std::vector<SplitResult> Polygon::split_many(const std::vector<double> &squares,
+                                             const SplitOptions &options) const {
+    return split_many(squares.data(), squares.size(), options);
+}
+
+void Polygon::split_many_row(int i, const Points &polygon, const AreaTable &areas,
+                             const EdgeBlocks &blocks, const EdgeGrid &edges,
+                             const std::vector<double> &squares, std::atomic<double> *min_sq_lengths,
+                             SplitCandidate *best) {
+    POLY_SPLIT_TRACE_SCOPE("pairs");
+    int polygon_size{static_cast<int>(polygon.size())};
+    size_t count{squares.size()};
+
+    for (int j = i + 1; j < polygon_size; j++) {
+        // The longest cut still wanted by any of the areas
+        double max_sq_length{0};
+        for (size_t k = 0; k < count; k++) {
+            max_sq_length = std::max(max_sq_length, min_sq_lengths[k].load(std::memory_order_relaxed));
+        }
+
+        if (j == i + 1 || j % EdgeBlocks::size == 0) {
+            size_t block{j / EdgeBlocks::size};
+            if (blocks.min_sq_length(i, block) > max_sq_length) {
+                int end{static_cast<int>((block + 1) * EdgeBlocks::size)};
+                POLY_SPLIT_COUNT(pairs_pruned, std::min(end, polygon_size) - j);
+                j = end - 1;
+                continue;
+            }
+        }
+
+        POLY_SPLIT_COUNT(pairs_visited, 1);
+        const Segment &s1{edges.edge(i)};
+        const Segment &s2{edges.edge(j)};
+
+        double min_sq_length{edges.min_sq_length(i, j)};
+        if (min_sq_length <= max_sq_length)
+            min_sq_length = Polygons::min_sq_length(s1, s2);
+
+        if (min_sq_length > max_sq_length) {
+            POLY_SPLIT_COUNT(pairs_pruned, 1);
+            continue;
+        }
+
+        int pc1{j - i};
+        int pc2{polygon_size - pc1};
+
+        double square1{areas.count_square_signed(i + 1, pc1)};
+        double square2{areas.count_square_signed((j + 1) % polygon_size, pc2)};
+        double max_total_square{Polygons::max_total_square(s1, s2)};
+
+        // The decomposition of each direction is built when an area needs it
+        std::optional<Polygons> forward;
+        std::optional<Polygons> backward;
+
+        for (size_t k = 0; k < count; k++) {
+            // The same steps as get_cut
+            double sn1{squares[k] + square2};
+            double sn2{squares[k] + square1};
+
+            bool reversed{sn1 <= 0};
+            double target{reversed ? sn2 : sn1};
+            if (target <= 0 || target > max_total_square) {
+                POLY_SPLIT_COUNT(pairs_rejected_by_area, 1);
+                continue;
+            }
+            if (min_sq_length > min_sq_lengths[k].load(std::memory_order_relaxed))
+                continue;
+
+            Segment cut;
+            if (!reversed) {
+                if (!forward) {
+                    POLY_SPLIT_COUNT(decompositions, 1);
+                    forward.emplace(s1, edges.norm(i), s2, edges.norm(j));
+                }
+                if (!forward->find_cut_line(target, cut))
+                    continue;
+            } else {
+                if (!backward) {
+                    POLY_SPLIT_COUNT(decompositions, 1);
+                    backward.emplace(s2, edges.norm(j), s1, edges.norm(i));
+                }
+                if (!backward->find_cut_line(target, cut))
+                    continue;
+                cut = cut.reverse();
+            }
+            POLY_SPLIT_COUNT(cuts_found, 1);
+
+            double sq_length{cut.square_length()};
+            if (sq_length < best[k].sq_length &&
+                sq_length <= min_sq_lengths[k].load(std::memory_order_relaxed) &&
+                edges.is_segment_inside(cut, i, j)) {
+                best[k].exists = true;
+                best[k].sq_length = sq_length;
+                best[k].i = i;
+                best[k].j = j;
+                best[k].cut = cut;
+
+                double current{min_sq_lengths[k].load(std::memory_order_relaxed)};
+                while (sq_length < current &&
+                       !min_sq_lengths[k].compare_exchange_weak(current, sq_length, std::memory_order_relaxed)) {}
+            }
+        }
+    }
+}
+
+void Polygon::split_row(int i, const Points &polygon, const AreaTable &areas,
+                        const EdgeBlocks &blocks, const EdgeGrid &edges,
+                        double square, std::atomic<double> &min_sq_length,
+                        SplitCandidate &best) {
+    POLY_SPLIT_TRACE_SCOPE("pairs");
+    int polygon_size{static_cast<int>(polygon.size())};
+
+    for (int j = i + 1; j < polygon_size; j++) {
+        // Skip the rest of the block when all of it is too far
+        if (j == i + 1 || j % EdgeBlocks::size == 0) {
+            size_t block{j / EdgeBlocks::size};
+            if (blocks.min_sq_length(i, block) > min_sq_length.load(std::memory_order_relaxed)) {
+                int end{static_cast<int>((block + 1) * EdgeBlocks::size)};
+                POLY_SPLIT_COUNT(pairs_pruned, std::min(end, polygon_size) - j);
+                j = end - 1;
+                continue;
+            }
+        }
+
+        split_pair(i, j, polygon, areas, edges, square, min_sq_length, best);
+    }
+}
+
+void Polygon::split_convex_row(int i, const Points &polygon, const AreaTable &areas,
+                               const EdgeGrid &edges, double square, double margin,
+                               std::atomic<double> &min_sq_length, SplitCandidate &best) {
+    POLY_SPLIT_TRACE_SCOPE("pairs");
+    int n{static_cast<int>(polygon.size())};
+
+    // Area of count consecutive vertices, all of them when they wrap around
+    auto area{[&](int first, int count) {
+        return fabs(areas.count_square_signed(first % n, std::min(count, n)));
+    }};
+
+    // First j of the row where a predicate that only turns from false
+    // to true holds, n if it does not
+    auto first{[&](auto holds) {
+        int lo{i + 1};
+        int hi{n};
+        while (lo < hi) {
+            int mid{lo + (hi - lo) / 2};
+            if (holds(mid)) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }};
+
+    // The cut leaves the square at the side of the vertices after j,
+    // whose area is between the one of j + 1..i and the one of j..i + 1,
+    // which shrink as j grows
+    int lo1{first([&](int j) { return area(j + 1, n - (j - i)) - margin <= square; })};
+    int end1{first([&](int j) { return area(j, n - (j - i) + 2) + margin < square; })};
+
+    // Or, when it is reversed, at the side of the vertices up to j,
+    // between the area of i + 1..j and the one of i..j + 1
+    int lo2{first([&](int j) { return area(i, j - i + 2) + margin >= square; })};
+    int end2{first([&](int j) { return area(i + 1, j - i) - margin > square; })};
+
+    for (int j = std::min(lo1, lo2); j < std::max(end1, end2); j++) {
+        if ((lo1 <= j && j < end1) || (lo2 <= j && j < end2)) {
+            split_pair(i, j, polygon, areas, edges, square, min_sq_length, best, true, margin);
+            continue;
+        }
+
+        int next{n};
+        if (j < lo1 && lo1 < end1)
+            next = std::min(next, lo1);
+        if (j < lo2 && lo2 < end2)
+            next = std::min(next, lo2);
+        j = next - 1;
+    }
+}
+
+void Polygon::split_pair(int i, int j, const Points &polygon, const AreaTable &areas,
+                         const EdgeGrid &edges, double square,
+                         std::atomic<double> &min_sq_length, SplitCandidate &best, bool convex, double margin) {
+    int polygon_size{static_cast<int>(polygon.size())};
+    int pc1{j - i};
+    int pc2{polygon_size - pc1};
+
+    double square1{areas.count_square_signed(i + 1, pc1)};
+    double square2{areas.count_square_signed((j + 1) % polygon_size, pc2)};
+
+    Segment cut;
+
+    // A cut between two edges of a convex polygon is inside it, but the
+    // formula of the trapezoid misses the area when the piece between the
+    // edges is another quadrilateral. So the part after j is measured in
+    // constant time: its vertices with the cut in place of the edge from
+    // i to j + 1. The area is on that part unless get_cut has reversed
+    // the pair
+    auto leaves_square{[&]() {
+        const Point &v{polygon[i]};
+        Point end{cut.get_end() - v};
+        Point start{cut.get_start() - v};
+        Point next{polygon[(j + 1) % polygon_size] - v};
+        double part{fabs(square2 - (end.x * start.y - start.x * end.y + start.x * next.y - next.x * start.y) / 2.0)};
+        if (square + square2 <= 0) {
+            part = fabs(areas.count_square_signed(0, polygon_size)) - part;
+        }
+        return fabs(part - square) <= margin;
+    }};
+
+    if (get_cut(edges, i, j, square, square1, square2,
+                min_sq_length.load(std::memory_order_relaxed), cut) == CutSearch::Found) {
+        double sq_length{cut.square_length()};
+
+        // A cut as long as the best one of a previous row may still
+        // win the tie, so only the longer ones are discarded
+        if (sq_length < best.sq_length &&
+            sq_length <= min_sq_length.load(std::memory_order_relaxed) &&
+            (convex ? leaves_square() : edges.is_segment_inside(cut, i, j))) {
+            best.exists = true;
+            best.sq_length = sq_length;
+            best.i = i;
+            best.j = j;
+            best.cut = cut;
+
+            double current{min_sq_length.load(std::memory_order_relaxed)};
+            while (sq_length < current &&
+                   !min_sq_length.compare_exchange_weak(current, sq_length, std::memory_order_relaxed)) {}
+        }
+    }
+}
+
+double Polygon::find_distance(const Point &point) const {
+    return view().find_distance(point);
+}
+
 Point Polygon::find_nearest_point(const Point &point) const {
     Point result;
     double distance{std::numeric_limits<double>::infinity()};
@@ -387,20 +1181,17 @@ void Polygon::split_nearest_edge(const Point &point) {
 }
 
 bool Polygon::is_point_inside(const Point &point) const {
-    int pointsCount{static_cast<int>(vertices.size()) - 1};
-    if (pointsCount < 2)
-        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+    return view().is_point_inside(point);
+}
 
-    Segment s{Line{point, Vector{0.0, 1e100}}};
-    int result{0};
-    Point p;
-    for (int i = 0; i < pointsCount; i++) {
-        Segment seg{vertices[i], vertices[i + 1]};
-        result += s.cross_line(seg, p);
-    }
-    Segment seg{vertices[pointsCount], vertices[0]};
-    result += s.cross_line(seg, p);
-    return result % 2 != 0;
+void Polygon::classify_points(const Point *points, size_t count, PointLocation *locations) const {
+    VertexArray{vertices}.classify_points(points, count, locations);
+}
+
+std::vector<PointLocation> Polygon::classify_points(const Points &points) const {
+    std::vector<PointLocation> locations(points.size());
+    classify_points(points.data(), points.size(), locations.data());
+    return locations;
 }
 
 bool Polygon::is_segment_inside(const Segment &segment, size_t excludeLine1, size_t excludeLine2) const {
@@ -426,42 +1217,57 @@ bool Polygon::is_segment_inside(const Segment &segment, size_t excludeLine1, siz
 }
 
 bool Polygon::is_clockwise() const {
-    if (vertices.size() < 2)
-        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+    return view().is_clockwise();
+}
 
-    double sum{0};
-    int t{static_cast<int>(vertices.size()) - 1};
-    for (int i = 0; i < t; i++) {
-        sum += (vertices[i + 1].x - vertices[i].x) * (vertices[i + 1].y + vertices[i].y);
-    }
-    sum += (vertices[0].x - vertices[t].x) * (vertices[0].y + vertices[t].y);
-    return sum <= 0;
+bool Polygon::is_convex() const {
+    return view().is_convex();
 }
 
-bool Polygon::get_cut(const Segment &s1, const Segment &s2, double s,
-            const Polygon &poly1, const Polygon &poly2,
+CutSearch Polygon::get_cut(const EdgeGrid &edges, size_t i, size_t j, double s,
+            double square1, double square2, double max_sq_length,
             Segment &cut) {
-    double sn1{s + poly2.count_square_signed()};
-    double sn2{s + poly1.count_square_signed()};
+    const Segment &s1{edges.edge(i)};
+    const Segment &s2{edges.edge(j)};
+    double sn1{s + square2};
+    double sn2{s + square1};
+
+    POLY_SPLIT_COUNT(pairs_visited, 1);
+    bool reversed{sn1 <= 0};
+    double target{reversed ? sn2 : sn1};
+
+    // The target does not fit between the edges
+    if (target <= 0 || target > Polygons::max_total_square(s1, s2)) {
+        POLY_SPLIT_COUNT(pairs_rejected_by_area, 1);
+        return CutSearch::Missing;
+    }
 
-    bool success{false};
+    // Edges farther apart than the longest allowed cut
+    if (edges.min_sq_length(i, j) > max_sq_length ||
+        Polygons::min_sq_length(s1, s2) > max_sq_length) {
+        POLY_SPLIT_COUNT(pairs_pruned, 1);
+        return CutSearch::Pruned;
+    }
 
-    if (sn1 > 0) {
-        Polygons res{s1, s2};
+    POLY_SPLIT_COUNT(decompositions, 1);
+    if (!reversed) {
+        Polygons res{s1, edges.norm(i), s2, edges.norm(j)};
 
-        if (res.find_cut_line(sn1, cut)) {
-            success = true;
+        if (res.find_cut_line(target, cut)) {
+            POLY_SPLIT_COUNT(cuts_found, 1);
+            return CutSearch::Found;
         }
-    } else if (sn2 > 0) {
-        Polygons res{s2, s1};
+    } else {
+        Polygons res{s2, edges.norm(j), s1, edges.norm(i)};
 
-        if (res.find_cut_line(sn2, cut)) {
+        if (res.find_cut_line(target, cut)) {
+            POLY_SPLIT_COUNT(cuts_found, 1);
             cut = cut.reverse();
-            success = true;
+            return CutSearch::Found;
         }
     }
 
-    return success;
+    return CutSearch::Missing;
 }
 
 void Polygon::push_back(const Point &p) {
@@ -22,22 +22,255 @@
 #pragma once
 
 #include "line.hpp"
+#include <atomic>
+#include <cfloat>
+#include <cstdint>
 #include <string>
 #include <exception>
 
-class Polygon {
+class ThreadPool;
+class IncrementalSplit;
+class PolygonWithHoles;
+class SplitWorkspace;
+struct SplitStats;
+
+enum class PointLocation : uint8_t {
+    Outside,
+    Inside,
+    Boundary
+};
+
+/**
+ * @brief Why a polygon was split or not.
+*/
+enum class SplitStatus : uint8_t {
+    Ok,
+    // The polygon has less than two vertices
+    NotEnoughPoints,
+    // The area is not smaller than the one of the polygon
+    AreaTooBig,
+    // No cut inside the polygon leaves the area
+    NoCut
+};
+
+/**
+ * @brief Returns the message of the exception that Polygon::split throws
+ * for the status.
+*/
+const char *split_status_message(SplitStatus status);
+
+struct SplitOptions {
+    /**
+     * Pool whose workers share the search of the edge pairs.
+     * The search is serial when it is null.
+    */
+    ThreadPool *pool{nullptr};
+
+    /**
+     * Counts of what the split does, added to the ones it holds. They
+     * are only counted when the library is built with POLY_SPLIT_STATS.
+    */
+    SplitStats *stats{nullptr};
+};
+
+/**
+ * @brief How far Polygon::simplify may move the boundary. A vertex is
+ * only removed while both bounds hold, so with both of them at zero
+ * only the collinear vertices are removed.
+*/
+struct SimplifyOptions {
+    // The farthest a removed vertex may be from the edge replacing it
+    double max_deviation{0};
+
+    // The largest change of the area of the polygon
+    double max_area_error{0};
+};
+
+namespace poly_private {
+struct AreaTable;
+struct EdgeBlocks;
+struct SplitCandidate;
+class EdgeGrid;
+
+/**
+ * @brief Outcome of the search of a cut between two edges.
+*/
+enum class CutSearch : uint8_t {
+    Found,
+    // No cut leaves the area between the edges
+    Missing,
+    // The edges are farther apart than the longest cut wanted
+    Pruned
+};
+};
+
+template <typename T>
+class BasicPolygon;
+
+using Polygon = BasicPolygon<double>;
+
+struct SplitResult;
+
+/**
+ * @brief Read-only polygon over vertices stored somewhere else, like
+ * the ones of a mapped Dataset. The algorithms of Polygon that do not
+ * change the vertices run on them without copying them first.
+*/
+class PolygonView {
+private:
+    const Point *vertices{nullptr};
+    size_t vertex_count{0};
+
+    /**
+     * @brief Searches the cut of split. The edges are only set when the
+     * status is SplitStatus::Ok.
+    */
+    SplitStatus find_split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+                           size_t &start_edge, size_t &end_edge, SplitWorkspace &workspace,
+                           const SplitOptions &options) const;
+
+public:
+    PolygonView() = default;
+    PolygonView(const Point *vertices, size_t count) : vertices{vertices}, vertex_count{count} {}
+    PolygonView(const Points &vertices) : vertices{vertices.data()}, vertex_count{vertices.size()} {}
+
+    /**
+     * @brief Same as the methods of Polygon with the same name.
+    */
+    double count_square(void) const;
+    double count_square_signed(void) const;
+    void split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+               const SplitOptions &options = SplitOptions{}) const;
+    void split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+               SplitWorkspace &workspace, const SplitOptions &options = SplitOptions{}) const;
+    SplitResult try_split(double square, const SplitOptions &options = SplitOptions{}) const;
+    void try_split(double square, SplitResult &result, SplitWorkspace &workspace,
+                   const SplitOptions &options = SplitOptions{}) const;
+    std::vector<SplitResult> split_many(const double *squares, size_t count,
+                                        const SplitOptions &options = SplitOptions{}) const;
+    std::vector<SplitResult> split_many(const std::vector<double> &squares,
+                                        const SplitOptions &options = SplitOptions{}) const;
+    Polygon simplify(const SimplifyOptions &simplify) const;
+    SplitResult split_simplified(double square, const SimplifyOptions &simplify,
+                                 const SplitOptions &options = SplitOptions{}) const;
+    double find_distance(const Point &point) const;
+    bool is_point_inside(const Point &point) const;
+    bool is_clockwise(void) const;
+    bool is_convex(void) const;
+
+    const Point *begin(void) const {
+        return vertices;
+    }
+
+    const Point *end(void) const {
+        return vertices + vertex_count;
+    }
+
+    const Point *data(void) const {
+        return vertices;
+    }
+
+    bool empty(void) const {
+        return vertex_count == 0;
+    }
+
+    Point operator[](size_t index) const {
+        return vertices[index];
+    }
+
+    size_t size(void) const {
+        return vertex_count;
+    }
+};
+
+/**
+ * @brief The polygon with double coordinates. The algorithms of the
+ * polygons with other coordinate types run on it.
+*/
+template <>
+class BasicPolygon<double> {
 private:
     Points vertices;
 
-    static bool get_cut(const Segment &s1, const Segment &s2, double s,
-                const Polygon &poly1, const Polygon &poly2,
+    /**
+     * @brief Finds the cut between the edges i and j of the ring of the
+     * grid that leaves the area s at the side of poly2.
+     *
+     * @param
+     * square1: The signed area of the polygon formed by the vertices
+     * between s1 and s2.
+     * @param
+     * square2: The signed area of the polygon formed by the vertices
+     * between s2 and s1.
+     * @param
+     * max_sq_length: The square of the length of the longest cut
+     * wanted. Edges farther apart are not decomposed.
+    */
+    static poly_private::CutSearch get_cut(const poly_private::EdgeGrid &edges, size_t i, size_t j, double s,
+                double square1, double square2, double max_sq_length,
                 Segment &cut);
 
+    /**
+     * @brief Looks for the shortest cut between the edge i and the
+     * following edges of the polygon. Cuts longer than min_sq_length
+     * are discarded without checking them.
+    */
+    static void split_row(int i, const Points &polygon, const poly_private::AreaTable &areas,
+                          const poly_private::EdgeBlocks &blocks, const poly_private::EdgeGrid &edges,
+                          double square, std::atomic<double> &min_sq_length,
+                          poly_private::SplitCandidate &best);
+
+    /**
+     * @brief Same as split_row for a convex polygon. Only the edges j
+     * whose areas around the pair bracket the square are searched, and
+     * they are found by binary search.
+    */
+    static void split_convex_row(int i, const Points &polygon, const poly_private::AreaTable &areas,
+                                 const poly_private::EdgeGrid &edges, double square, double margin,
+                                 std::atomic<double> &min_sq_length, poly_private::SplitCandidate &best);
+
+    /**
+     * @brief Searches the cut between the edges i and j for split_row.
+     * For a convex polygon any cut between two edges is inside, so it is
+     * not checked against the edges. Only the area it leaves is checked,
+     * within the margin.
+    */
+    static void split_pair(int i, int j, const Points &polygon, const poly_private::AreaTable &areas,
+                           const poly_private::EdgeGrid &edges, double square,
+                           std::atomic<double> &min_sq_length, poly_private::SplitCandidate &best,
+                           bool convex = false, double margin = 0);
+
+    /**
+     * @brief Looks for the shortest cut of every area between the edge i
+     * and the following edges of the polygon. The decompositions of an
+     * edge pair are built once for all the areas.
+    */
+    static void split_many_row(int i, const Points &polygon, const poly_private::AreaTable &areas,
+                               const poly_private::EdgeBlocks &blocks, const poly_private::EdgeGrid &edges,
+                               const std::vector<double> &squares, std::atomic<double> *min_sq_lengths,
+                               poly_private::SplitCandidate *best);
+
+    /**
+     * @brief Builds poly1, poly2 and cut_line from the best cut found in
+     * the clockwise copy of the vertices.
+    */
+    static void split_parts(const Points &polygon, const poly_private::SplitCandidate &best,
+                            Polygon &poly1, Polygon &poly2, Segment &cut_line);
+
+    friend class IncrementalSplit;
+    friend class PolygonView;
+    friend class PolygonWithHoles;
+
 public:
-    Polygon();
-    Polygon(const Polygon &p);
+    BasicPolygon();
+    BasicPolygon(const BasicPolygon &p);
 
-    Polygon(const Points &p);
+    BasicPolygon(const Points &p);
+
+    /**
+     * @brief Copies the vertices of the view.
+    */
+    explicit BasicPolygon(const PolygonView &view);
 
     class NotEnoughPointsException : public std::exception {
         std::string message{"The polygon has not enough vertices"};
@@ -75,12 +308,76 @@ public:
      * poly2: The resulting polygon with the specified area.
      * @param
      * cut_line: The line dividing the two polygons.
+     * @param
+     * options: How the search is carried out. The result does not
+     * depend on them.
      * 
      * @returns
      * true: if it is possible.
      * false: if it is not possible.
     */
-    void split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line) const;
+    void split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+               const SplitOptions &options = SplitOptions{}) const;
+
+    /**
+     * @brief Same as split, but the search keeps its memory in the
+     * workspace. Repeated splits with the same workspace and the same
+     * poly1 and poly2 do not allocate, unless they throw.
+    */
+    void split(double square, Polygon &poly1, Polygon &poly2, Segment &cut_line,
+               SplitWorkspace &workspace, const SplitOptions &options = SplitOptions{}) const;
+
+    /**
+     * @brief Same as split, but the failures are reported in the status
+     * of the result instead of thrown. The parts are set as split leaves
+     * them, and poly1 is set like the CannotSplitException of split.
+    */
+    SplitResult try_split(double square, const SplitOptions &options = SplitOptions{}) const;
+
+    /**
+     * @brief Same as try_split, writing in result and reusing the memory
+     * of the workspace and of the parts of result, like split.
+    */
+    void try_split(double square, SplitResult &result, SplitWorkspace &workspace,
+                   const SplitOptions &options = SplitOptions{}) const;
+
+    /**
+     * @brief Splits the polygon once for every area in squares, with
+     * the same results as split. The search of the edge pairs is shared
+     * by all the areas, so it is faster than a split for each one.
+     *
+     * @returns
+     * The result of every area, in the same order. The ones that can not
+     * be split have exists set to false and poly1 set like the
+     * CannotSplitException of split.
+    */
+    std::vector<SplitResult> split_many(const double *squares, size_t count,
+                                        const SplitOptions &options = SplitOptions{}) const;
+    std::vector<SplitResult> split_many(const std::vector<double> &squares,
+                                        const SplitOptions &options = SplitOptions{}) const;
+
+    /**
+     * @brief Returns the polygon without the vertices that can be removed
+     * within the bounds of the options, the least significant first
+     * (Visvalingam-Whyatt). The rest keep their order, and at least
+     * three of them are kept.
+    */
+    Polygon simplify(const SimplifyOptions &simplify) const;
+
+    /**
+     * @brief Same as try_split, but the cut is searched first in the
+     * simplified polygon. The pairs of the original edges around the
+     * ends of that cut are then searched as split does, so the area is
+     * exact and the cut lies on the original edges. When none of them
+     * has a cut, the whole polygon is searched.
+     *
+     * The cut may be longer than the one of split when another one, far
+     * from it, is shorter by less than about twice max_deviation. Like
+     * split, poly2 may get the rest of the area instead, but only when
+     * no cut near the ones found leaves the area at its side.
+    */
+    SplitResult split_simplified(double square, const SimplifyOptions &simplify,
+                                 const SplitOptions &options = SplitOptions{}) const;
 
     /**
      * @brief Returns the distance between the nearest point of the polygon
@@ -120,6 +417,17 @@ public:
     */
     bool is_point_inside(const Point &point) const;
 
+    /**
+     * @brief Writes in locations[k] where points[k] lies. The points
+     * closer than POLY_SPLIT_EPS to an edge are on the boundary, the
+     * rest are classified by the crossings of a horizontal ray.
+     *
+     * @throws
+     * Polygon::NotEnoughPointsException: if the polygon has less than three vertices.
+    */
+    void classify_points(const Point *points, size_t count, PointLocation *locations) const;
+    std::vector<PointLocation> classify_points(const Points &points) const;
+
     /**
      * @brief Returns true if the segment passed by parameters is contained
      * within the edges of the polygon. 
@@ -136,10 +444,23 @@ public:
     */
     bool is_clockwise(void) const;
 
+    /**
+     * @brief Returns true if the polygon is convex and goes around once.
+     * Collinear and repeated vertices are allowed.
+    */
+    bool is_convex(void) const;
+
     const Points get_vertices(void) const {
         return vertices;
     }
 
+    /**
+     * @brief Returns a view of the vertices, valid until they change.
+    */
+    PolygonView view(void) const {
+        return PolygonView{vertices};
+    }
+
     /**
      * @brief If the point passed by parameters was not a vertex of the
      * polygon, now it is.
@@ -181,16 +502,299 @@ public:
     }
 };
 
+/**
+ * @brief The outcome of Polygon::try_split and of every area of
+ * Polygon::split_many.
+*/
+struct SplitResult {
+    SplitStatus status{SplitStatus::NoCut};
+    // Whether the status is SplitStatus::Ok
+    bool exists{false};
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut_line;
+
+    // The edges where the cut line starts and ends, numbered by the
+    // vertex they start from. They are only set when the cut exists.
+    size_t start_edge{0};
+    size_t end_edge{0};
+};
+
+/**
+ * @brief A storage adapter that keeps the vertices in another coordinate
+ * type, like float to halve the memory of polygons at rest or int64_t
+ * for a snapped grid. It is not a float or integer version of the
+ * algorithms: every call converts the vertices to a temporary Polygon,
+ * runs in double with POLY_SPLIT_EPS and rounds the points it returns
+ * back with ScalarTraits<T>::convert. While a call runs the polygon also
+ * takes its double copy, and int64_t coordinates get no exact integer
+ * arithmetic.
+*/
+template <typename T>
+class BasicPolygon {
+private:
+    using Point = BasicPoint<T>;
+    using Points = std::vector<BasicPoint<T>>;
+
+    Points vertices;
+
+    ::Polygon engine(void) const {
+        ::Points points;
+        points.reserve(vertices.size());
+        for (const Point &v : vertices) {
+            points.push_back(::Point{v});
+        }
+
+        return ::Polygon{points};
+    }
+
+    static Points convert(const ::Points &points) {
+        Points result;
+        result.reserve(points.size());
+        for (const ::Point &p : points) {
+            result.push_back(Point{p});
+        }
+
+        return result;
+    }
+
+public:
+    using NotEnoughPointsException = ::Polygon::NotEnoughPointsException;
+    using CannotSplitException = ::Polygon::CannotSplitException;
+
+    BasicPolygon() = default;
+    BasicPolygon(const Points &p) : vertices{p} {}
+
+    /**
+     * @brief Rounds the vertices of a Polygon to this coordinate type.
+    */
+    explicit BasicPolygon(const ::Polygon &p) : vertices{convert(p.get_vertices())} {}
+
+    double count_square(void) const {
+        return engine().count_square();
+    }
+
+    double count_square_signed(void) const {
+        return engine().count_square_signed();
+    }
+
+    /**
+     * @brief Same as Polygon::split. The cut line keeps the double
+     * coordinates, while the end points of the cut are rounded in the
+     * vertices of poly1 and poly2.
+    */
+    void split(double square, BasicPolygon &poly1, BasicPolygon &poly2, Segment &cut_line,
+               const SplitOptions &options = SplitOptions{}) const {
+        ::Polygon p1;
+        ::Polygon p2;
+        try {
+            engine().split(square, p1, p2, cut_line, options);
+        } catch (const CannotSplitException &) {
+            poly1 = BasicPolygon{p1};
+            throw;
+        }
+
+        poly1 = BasicPolygon{p1};
+        poly2 = BasicPolygon{p2};
+    }
+
+    double find_distance(const Point &point) const {
+        return engine().find_distance(::Point{point});
+    }
+
+    Point find_nearest_point(const Point &point) const {
+        return Point{engine().find_nearest_point(::Point{point})};
+    }
+
+    Point find_center(void) const {
+        return Point{engine().find_center()};
+    }
+
+    void split_nearest_edge(const Point &point) {
+        ::Polygon polygon{engine()};
+        polygon.split_nearest_edge(::Point{point});
+        vertices = convert(polygon.get_vertices());
+    }
+
+    bool is_point_inside(const Point &point) const {
+        return engine().is_point_inside(::Point{point});
+    }
+
+    void classify_points(const Point *points, size_t count, PointLocation *locations) const {
+        ::Points converted;
+        converted.reserve(count);
+        for (size_t k = 0; k < count; k++) {
+            converted.push_back(::Point{points[k]});
+        }
+
+        engine().classify_points(converted.data(), count, locations);
+    }
+
+    std::vector<PointLocation> classify_points(const Points &points) const {
+        std::vector<PointLocation> locations(points.size());
+        classify_points(points.data(), points.size(), locations.data());
+        return locations;
+    }
+
+    bool is_segment_inside(const Segment &segment, size_t exclude_line1, size_t exclude_line2) const {
+        return engine().is_segment_inside(segment, exclude_line1, exclude_line2);
+    }
+
+    bool is_clockwise(void) const {
+        return engine().is_clockwise();
+    }
+
+    bool is_convex(void) const {
+        return engine().is_convex();
+    }
+
+    const Points get_vertices(void) const {
+        return vertices;
+    }
+
+    void push_back(const Point &point) {
+        vertices.push_back(point);
+    }
+
+    bool empty(void) const {
+        return vertices.empty();
+    }
+
+    Point &operator[](size_t index) {
+        return vertices[index];
+    }
+
+    Point operator[](size_t index) const {
+        return vertices[index];
+    }
+
+    void clear(void) {
+        vertices.clear();
+    }
+
+    size_t size(void) const {
+        return vertices.size();
+    }
+};
+
 namespace poly_private {
+/**
+ * @brief Cumulative shoelace terms of a closed ring. It allows to get
+ * the signed area of any cyclic range of vertices in constant time.
+*/
+struct AreaTable {
+    AreaTable() = default;
+    AreaTable(const Points &vertices);
+
+    /**
+     * @brief Builds the table of other vertices, reusing the memory.
+    */
+    void assign(const Points &vertices);
+
+    /**
+     * @brief Returns the same value that Polygon::count_square_signed
+     * returns for the polygon formed by count consecutive vertices of
+     * the ring, starting at first.
+    */
+    double count_square_signed(size_t first, size_t count) const;
+
+    // Vertices relative to the first one, to keep the terms small
+    Points ring;
+    std::vector<double> prefix;
+};
+
+/**
+ * @brief Bounding boxes of runs of consecutive edges of a ring. They
+ * allow to discard at once the edges too far from another one.
+*/
+struct EdgeBlocks {
+    static const size_t size{32};
+
+    EdgeBlocks() = default;
+    EdgeBlocks(const Points &ring);
+
+    /**
+     * @brief Builds the blocks of another ring, reusing the memory.
+    */
+    void assign(const Points &ring);
+
+    /**
+     * @brief Returns a lower bound of the square of the length of any
+     * cut between the edge and the edges of the block, like
+     * Polygons::min_sq_length.
+    */
+    double min_sq_length(size_t edge, size_t block) const;
+
+    Points ring;
+    Points min;
+    Points max;
+};
+
+/**
+ * @brief The shortest cut found among some edge pairs. Ties are
+ * resolved in favour of the first pair.
+*/
+struct SplitCandidate {
+    bool exists{false};
+    double sq_length{DBL_MAX};
+    int i{0};
+    int j{0};
+    Segment cut;
+};
+
+/**
+ * @brief One of the pieces of Polygons. It has six vertices at most, so
+ * they are kept in place.
+*/
+struct Piece {
+    Point points[6];
+    size_t count{0};
+
+    void push_back(const Point &point) {
+        points[count++] = point;
+    }
+
+    bool empty(void) const {
+        return count == 0;
+    }
+
+    Point operator[](size_t index) const {
+        return points[index];
+    }
+
+    double count_square(void) const {
+        return PolygonView{points, count}.count_square();
+    }
+};
+
 struct Polygons {
     Polygons(const Segment &s1, const Segment &s2);
+
+    /**
+     * @brief Same as the other constructor with the norms of s1 and s2
+     * already known.
+    */
+    Polygons(const Segment &s1, double norm1, const Segment &s2, double norm2);
     bool find_cut_line(double square, Segment &cut_line);
 
+    /**
+     * @brief Returns an upper bound of the total_square of the
+     * decomposition between s1 and s2 without building it.
+    */
+    static double max_total_square(const Segment &s1, const Segment &s2);
+
+    /**
+     * @brief Returns a lower bound of the square of the length of any
+     * cut between s1 and s2, which is their distance minus the tolerance
+     * of the cut end points.
+    */
+    static double min_sq_length(const Segment &s1, const Segment &s2);
+
     Line bisector;
 
-    Polygon left_triangle;
-    Polygon trapezoid;
-    Polygon right_triangle;
+    Piece left_triangle;
+    Piece trapezoid;
+    Piece right_triangle;
 
     bool p1_exist;
     bool p2_exist;
@@ -0,0 +1,349 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "polygon_with_holes.hpp"
+#include "split_trace.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+
+using namespace poly_private;
+
+namespace {
+/**
+ * @brief Returns true if the horizontal ray from the point to the right
+ * crosses the segment from a to b.
+*/
+bool ray_crosses(const Point &point, const Point &a, const Point &b) {
+    return (a.y > point.y) != (b.y > point.y) &&
+           point.x < a.x + (point.y - a.y) * (b.x - a.x) / (b.y - a.y);
+}
+};
+
+namespace poly_private {
+/**
+ * @brief The holes prepared for the search of the cuts of a clockwise
+ * ring. Every hole is located by one of its vertices, and the crossings
+ * of the ray from it with the edges of the ring are counted beforehand,
+ * so the part of a cut where it lies is known without visiting the
+ * edges again.
+*/
+struct HoleTable {
+    HoleTable(const Points &ring, const std::vector<Polygon> &holes, const std::vector<EdgeGrid> &grids);
+
+    /**
+     * @brief Returns true if the hole lies in the poly2 that split_parts
+     * builds from the cut between the edges i and j.
+    */
+    bool is_in_poly2(size_t hole, int i, int j, const Segment &cut) const;
+
+    /**
+     * @brief Returns the area of the holes in poly2, or in poly1 when
+     * poly2 is false.
+    */
+    double count_square(int i, int j, const Segment &cut, bool poly2) const;
+
+    /**
+     * @brief Returns true if the segment crosses the edges of a hole.
+    */
+    bool crosses(const Segment &segment) const;
+
+    const Points &ring;
+    const std::vector<EdgeGrid> &grids;
+    std::vector<double> squares;
+    double total_square{0};
+    Points points;
+    Points min;
+    Points max;
+
+    // The crossings of the ray of every hole with the first k edges of
+    // the ring, n + 1 counts for each hole
+    std::vector<uint32_t> crossings;
+};
+};
+
+HoleTable::HoleTable(const Points &ring, const std::vector<Polygon> &holes, const std::vector<EdgeGrid> &grids) :
+    ring{ring}, grids{grids} {
+    size_t n{ring.size()};
+    crossings.reserve(holes.size() * (n + 1));
+
+    for (const Polygon &hole : holes) {
+        const Points vertices{hole.get_vertices()};
+        squares.push_back(hole.count_square());
+        total_square += squares.back();
+        points.push_back(vertices[0]);
+
+        auto [min_x, max_x] = std::minmax_element(vertices.begin(), vertices.end(),
+                                                  [](const Point &a, const Point &b) { return a.x < b.x; });
+        auto [min_y, max_y] = std::minmax_element(vertices.begin(), vertices.end(),
+                                                  [](const Point &a, const Point &b) { return a.y < b.y; });
+        min.push_back(Point{min_x->x, min_y->y});
+        max.push_back(Point{max_x->x, max_y->y});
+
+        uint32_t count{0};
+        crossings.push_back(count);
+        for (size_t k = 0; k < n; k++) {
+            count += ray_crosses(vertices[0], ring[k], ring[k + 1 < n ? k + 1 : 0]);
+            crossings.push_back(count);
+        }
+    }
+}
+
+bool HoleTable::is_in_poly2(size_t hole, int i, int j, const Segment &cut) const {
+    size_t n{ring.size()};
+    const uint32_t *counts{&crossings[hole * (n + 1)]};
+    const Point &point{points[hole]};
+
+    // The whole edges of poly2 go from j + 1 to the end and from the
+    // start to i - 1. The cut ends on the edge i and starts on the edge j
+    uint32_t count{counts[n] - counts[j + 1] + counts[i]};
+    count += ray_crosses(point, ring[i], cut.get_end());
+    count += ray_crosses(point, cut.get_end(), cut.get_start());
+    count += ray_crosses(point, cut.get_start(), ring[(j + 1) % n]);
+    return count % 2 == 1;
+}
+
+double HoleTable::count_square(int i, int j, const Segment &cut, bool poly2) const {
+    double square{0};
+    for (size_t hole = 0; hole < squares.size(); hole++) {
+        if (is_in_poly2(hole, i, j, cut) == poly2)
+            square += squares[hole];
+    }
+
+    return square;
+}
+
+bool HoleTable::crosses(const Segment &segment) const {
+    Point start{segment.get_start()};
+    Point end{segment.get_end()};
+    for (size_t hole = 0; hole < grids.size(); hole++) {
+        if (std::max(start.x, end.x) < min[hole].x - POLY_SPLIT_EPS || max[hole].x + POLY_SPLIT_EPS < std::min(start.x, end.x) ||
+            std::max(start.y, end.y) < min[hole].y - POLY_SPLIT_EPS || max[hole].y + POLY_SPLIT_EPS < std::min(start.y, end.y))
+            continue;
+
+        if (grids[hole].crosses(segment, SIZE_MAX, SIZE_MAX))
+            return true;
+    }
+
+    return false;
+}
+
+PolygonWithHoles::PolygonWithHoles(const Polygon &outer, const std::vector<Polygon> &holes) : outer_ring{outer} {
+    for (const Polygon &hole : holes) {
+        add_hole(hole);
+    }
+}
+
+void PolygonWithHoles::add_hole(const Polygon &hole) {
+    if (hole.size() >= 3) {
+        hole_rings.push_back(hole);
+        hole_grids.emplace_back(hole.get_vertices());
+    }
+}
+
+double PolygonWithHoles::count_square(void) const {
+    double square{outer_ring.count_square()};
+    for (const Polygon &hole : hole_rings) {
+        square -= hole.count_square();
+    }
+
+    return square;
+}
+
+bool PolygonWithHoles::is_point_inside(const Point &point) const {
+    if (!outer_ring.is_point_inside(point))
+        return false;
+
+    for (const Polygon &hole : hole_rings) {
+        if (hole.is_point_inside(point))
+            return false;
+    }
+
+    return true;
+}
+
+bool PolygonWithHoles::is_segment_inside(const Segment &segment, size_t exclude_line1, size_t exclude_line2) const {
+    if (!outer_ring.is_segment_inside(segment, exclude_line1, exclude_line2))
+        return false;
+
+    for (const EdgeGrid &edges : hole_grids) {
+        if (edges.crosses(segment, SIZE_MAX, SIZE_MAX) || edges.is_point_inside(segment.get_point_along(0.5)))
+            return false;
+    }
+
+    return true;
+}
+
+size_t PolygonWithHoles::size(void) const {
+    size_t count{outer_ring.size()};
+    for (const Polygon &hole : hole_rings) {
+        count += hole.size();
+    }
+
+    return count;
+}
+
+void PolygonWithHoles::split(double square, PolygonWithHoles &poly1, PolygonWithHoles &poly2, Segment &cut_line,
+                             const SplitOptions &options) const {
+    size_t n{outer_ring.size()};
+    if (n < 2)
+        throw Polygon::NotEnoughPointsException{split_status_message(SplitStatus::NotEnoughPoints)};
+
+    poly1 = PolygonWithHoles{};
+    poly2 = PolygonWithHoles{};
+    if (count_square() - square <= POLY_SPLIT_EPS) {
+        poly1 = *this;
+        throw Polygon::CannotSplitException{split_status_message(SplitStatus::AreaTooBig)};
+    }
+
+    POLY_SPLIT_TRACE_SCOPE("prepare");
+    Points polygon{outer_ring.get_vertices()};
+    if (!outer_ring.is_clockwise()) {
+        std::reverse(polygon.begin(), polygon.end());
+    }
+
+    AreaTable areas{polygon};
+    EdgeBlocks blocks{polygon};
+    EdgeGrid edges{polygon};
+    HoleTable holes{polygon, hole_rings, hole_grids};
+    std::atomic<double> min_sq_length{DBL_MAX};
+    std::vector<SplitCandidate> rows(n - 1);
+    POLY_SPLIT_TRACE_NEXT("search");
+
+    // The rows of Polygon::split_row, with the pairs of split_pair
+    auto search{[&](size_t row) {
+        int i{static_cast<int>(row)};
+        int polygon_size{static_cast<int>(n)};
+        for (int j = i + 1; j < polygon_size; j++) {
+            if (j == i + 1 || j % EdgeBlocks::size == 0) {
+                size_t block{j / EdgeBlocks::size};
+                if (blocks.min_sq_length(i, block) > min_sq_length.load(std::memory_order_relaxed)) {
+                    j = static_cast<int>((block + 1) * EdgeBlocks::size) - 1;
+                    continue;
+                }
+            }
+
+            split_pair(i, j, polygon, areas, edges, holes, square, min_sq_length, rows[row]);
+        }
+    }};
+
+    if (options.pool != nullptr) {
+        options.pool->run(rows.size(), std::ref(search));
+    } else {
+        for (size_t row = 0; row < rows.size(); row++) {
+            search(row);
+        }
+    }
+
+    SplitCandidate best;
+    for (const SplitCandidate &row : rows) {
+        if (row.exists && row.sq_length < best.sq_length) {
+            best = row;
+        }
+    }
+
+    if (!best.exists) {
+        poly1 = *this;
+        throw Polygon::CannotSplitException{split_status_message(SplitStatus::NoCut)};
+    }
+
+    POLY_SPLIT_TRACE_NEXT("parts");
+    Polygon::split_parts(polygon, best, poly1.outer_ring, poly2.outer_ring, cut_line);
+    for (size_t hole = 0; hole < hole_rings.size(); hole++) {
+        PolygonWithHoles &part{holes.is_in_poly2(hole, best.i, best.j, best.cut) ? poly2 : poly1};
+        part.hole_rings.push_back(hole_rings[hole]);
+        part.hole_grids.push_back(hole_grids[hole]);
+    }
+}
+
+void PolygonWithHoles::split_pair(int i, int j, const Points &polygon, const AreaTable &areas,
+                                  const EdgeGrid &edges, const HoleTable &holes, double square,
+                                  std::atomic<double> &min_sq_length, SplitCandidate &best) {
+    int polygon_size{static_cast<int>(polygon.size())};
+    int pc1{j - i};
+    int pc2{polygon_size - pc1};
+
+    double square1{areas.count_square_signed(i + 1, pc1)};
+    double square2{areas.count_square_signed((j + 1) % polygon_size, pc2)};
+
+    const Segment &s1{edges.edge(i)};
+    const Segment &s2{edges.edge(j)};
+    Segment cut;
+
+    // The holes are only located for the pairs near enough, and where
+    // some area of them lets the target fit, as Polygon::get_cut checks
+    double max_sq_length{min_sq_length.load(std::memory_order_relaxed)};
+    if (edges.min_sq_length(i, j) > max_sq_length || Polygons::min_sq_length(s1, s2) > max_sq_length)
+        return;
+
+    double max_square{Polygons::max_total_square(s1, s2)};
+    auto fits{[&](double target) {
+        return target + holes.total_square > 0 && target <= max_square;
+    }};
+    if (!fits(square + square2) && !fits(square + square1))
+        return;
+
+    // The cut is near the chord between the middle of the edges, so the
+    // holes are first taken at its sides
+    const Segment chord{(polygon[j] + polygon[(j + 1) % polygon_size]) * 0.5, (polygon[i] + polygon[i + 1]) * 0.5};
+    double holes2{holes.count_square(i, j, chord, true)};
+    double holes1{holes.total_square - holes2};
+
+    // Polygon::get_cut leaves the area at the side of poly1 when the
+    // vertices of poly2 already have more. The side is kept while the
+    // area of the holes changes, by moving it to square2
+    bool poly2{square + holes2 + square2 > 0};
+    double holes_square{poly2 ? holes2 : holes1};
+
+    // The part that takes the area also takes the holes in it, which
+    // are only known once the cut is. It is searched again with their
+    // area until they do not change
+    bool found{false};
+    for (size_t tries = 0; tries <= holes.squares.size() && !found; tries++) {
+        if (Polygon::get_cut(edges, i, j, square + holes_square, square1, poly2 ? square2 : square2 - holes_square,
+                             min_sq_length.load(std::memory_order_relaxed), cut) != CutSearch::Found)
+            return;
+
+        double inside{holes.count_square(i, j, cut, poly2)};
+        found = inside == holes_square;
+        holes_square = inside;
+    }
+
+    if (!found)
+        return;
+
+    double sq_length{cut.square_length()};
+    if (sq_length < best.sq_length &&
+        sq_length <= min_sq_length.load(std::memory_order_relaxed) &&
+        edges.is_segment_inside(cut, i, j) && !holes.crosses(cut)) {
+        best.exists = true;
+        best.sq_length = sq_length;
+        best.i = i;
+        best.j = j;
+        best.cut = cut;
+
+        double current{min_sq_length.load(std::memory_order_relaxed)};
+        while (sq_length < current &&
+               !min_sq_length.compare_exchange_weak(current, sq_length, std::memory_order_relaxed)) {}
+    }
+}
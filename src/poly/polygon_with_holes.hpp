@@ -0,0 +1,111 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "polygon.hpp"
+#include "edge_grid.hpp"
+
+namespace poly_private {
+struct HoleTable;
+};
+
+/**
+ * @brief A polygon with holes, like a parcel around a courtyard. The
+ * holes must lie inside the outer ring and apart from each other. The
+ * area, the containment and the cuts of split leave the holes out
+ * without joining them to the outer ring.
+*/
+class PolygonWithHoles {
+    private:
+        Polygon outer_ring;
+        std::vector<Polygon> hole_rings;
+
+        // The grids of the holes, built once when they are added
+        std::vector<poly_private::EdgeGrid> hole_grids;
+
+        /**
+         * @brief Same as Polygon::split_pair, moving the area of the holes
+         * at the side of the cut that takes the area to the area wanted,
+         * and discarding the cuts that cross a hole.
+        */
+        static void split_pair(int i, int j, const Points &polygon, const poly_private::AreaTable &areas,
+                               const poly_private::EdgeGrid &edges, const poly_private::HoleTable &holes,
+                               double square, std::atomic<double> &min_sq_length,
+                               poly_private::SplitCandidate &best);
+
+    public:
+        PolygonWithHoles() = default;
+        PolygonWithHoles(const Polygon &outer, const std::vector<Polygon> &holes = {});
+
+        /**
+         * @brief Adds a hole. Holes with less than three vertices are
+         * ignored.
+        */
+        void add_hole(const Polygon &hole);
+
+        const Polygon &outer(void) const {
+            return outer_ring;
+        }
+
+        const std::vector<Polygon> &holes(void) const {
+            return hole_rings;
+        }
+
+        /**
+         * @brief Returns the area of the outer ring without the holes.
+        */
+        double count_square(void) const;
+
+        /**
+         * @brief Returns true if the point is inside the outer ring and
+         * outside the holes.
+        */
+        bool is_point_inside(const Point &point) const;
+
+        /**
+         * @brief Returns true if the segment is inside the outer ring and
+         * does not go through the holes.
+         *
+         * @param
+         * exclude_line1: The index of the first edge of the outer ring to be disregarded in the analysis.
+         * @param
+         * exclude_line2: The index of the second edge of the outer ring to be disregarded in the analysis.
+        */
+        bool is_segment_inside(const Segment &segment, size_t exclude_line1, size_t exclude_line2) const;
+
+        /**
+         * @brief Same as Polygon::split. Only the cuts between two edges of
+         * the outer ring that go around the holes are searched, and every
+         * hole goes to the part where it lies.
+         *
+         * @throws
+         * Polygon::NotEnoughPointsException: if the outer ring has less than two vertices.
+         * @throws
+         * Polygon::CannotSplitException: if no cut leaves the area.
+        */
+        void split(double square, PolygonWithHoles &poly1, PolygonWithHoles &poly2, Segment &cut_line,
+                   const SplitOptions &options = SplitOptions{}) const;
+
+        /**
+         * @brief Returns the number of vertices of all the rings.
+        */
+        size_t size(void) const;
+};
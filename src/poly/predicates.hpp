@@ -0,0 +1,199 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace poly_private {
+/**
+ * @brief Error-free arithmetic on floating point numbers, following
+ * Shewchuk's "Adaptive Precision Floating-Point Arithmetic and Fast
+ * Robust Geometric Predicates". Every function returns the rounded
+ * result in x and its rounding error in y, so that x + y is exact.
+*/
+template <typename T>
+struct Exact {
+    static_assert(std::numeric_limits<T>::radix == 2, "The predicates need binary floating point numbers");
+
+    // Half of the distance between 1 and the next number
+    static constexpr T epsilon{std::numeric_limits<T>::epsilon() / 2};
+
+    // 2^ceil(digits / 2) + 1, to split a number in two halves
+    static constexpr T splitter{static_cast<T>((1ull << ((std::numeric_limits<T>::digits + 1) / 2)) + 1)};
+
+    // Bounds of the error of the fast path of the predicates
+    static constexpr T det2_bound{(3 + 16 * epsilon) * epsilon};
+    static constexpr T orient2d_bound{(3 + 16 * epsilon) * epsilon};
+
+    static constexpr void two_sum(T a, T b, T &x, T &y) {
+        x = a + b;
+        T b_virtual{x - a};
+        T a_virtual{x - b_virtual};
+        y = (a - a_virtual) + (b - b_virtual);
+    }
+
+    static constexpr void split(T a, T &hi, T &lo) {
+        T c{splitter * a};
+        T big{c - a};
+        hi = c - big;
+        lo = a - hi;
+    }
+
+    static constexpr void two_product(T a, T b, T &x, T &y) {
+        x = a * b;
+#if defined(__FMA__) || defined(FP_FAST_FMA)
+        // The compiler could fuse the products of the split below
+        y = std::fma(a, b, -x);
+#else
+        T a_hi{0}, a_lo{0}, b_hi{0}, b_lo{0};
+        split(a, a_hi, a_lo);
+        split(b, b_hi, b_lo);
+        T err{x - a_hi * b_hi};
+        err -= a_lo * b_hi;
+        err -= a_hi * b_lo;
+        y = a_lo * b_lo - err;
+#endif
+    }
+
+    /**
+     * @brief Returns the most significant component of the exact sum
+     * of the terms, which has its sign and is within one rounding of
+     * its value. The terms are replaced by the components of the sum,
+     * in increasing order of magnitude.
+    */
+    static constexpr T sum(T *terms, size_t count) {
+        // Grow-Expansion: every term is added to the components so far
+        for (size_t k = 1; k < count; k++) {
+            T q{terms[k]};
+            for (size_t i = 0; i < k; i++) {
+                T h{0};
+                two_sum(q, terms[i], q, h);
+                terms[i] = h;
+            }
+            terms[k] = q;
+        }
+
+        for (size_t k = count; k > 0; k--) {
+            if (terms[k - 1] != 0)
+                return terms[k - 1];
+        }
+
+        return 0;
+    }
+};
+
+/**
+ * @brief Returns a * d - b * c with its exact sign. It is the floating
+ * point result unless that is too close to zero to trust its sign.
+*/
+template <typename T>
+constexpr T det2(T a, T b, T c, T d) {
+    using E = Exact<T>;
+
+    T left{a * d};
+    T right{b * c};
+    T det{left - right};
+
+    T bound{E::det2_bound * ((left < 0 ? -left : left) + (right < 0 ? -right : right))};
+    if (det > bound || -det > bound)
+        return det;
+
+    T terms[4]{0, 0, 0, 0};
+    E::two_product(a, d, terms[1], terms[0]);
+    E::two_product(-b, c, terms[3], terms[2]);
+    return E::sum(terms, 4);
+}
+
+/**
+ * @brief Returns a value that is positive when c lies to the left of
+ * the line from a to b, negative when it lies to the right and zero
+ * when the three points are collinear. The sign is always exact.
+*/
+template <typename T>
+constexpr T orient2d(T ax, T ay, T bx, T by, T cx, T cy) {
+    using E = Exact<T>;
+
+    T left{(ax - cx) * (by - cy)};
+    T right{(ay - cy) * (bx - cx)};
+    T det{left - right};
+
+    // The sign is right when both products do not have the same sign
+    T sum{0};
+    if (left > 0) {
+        if (right <= 0)
+            return det;
+        sum = left + right;
+    } else if (left < 0) {
+        if (right >= 0)
+            return det;
+        sum = -left - right;
+    } else {
+        return det;
+    }
+
+    T bound{E::orient2d_bound * sum};
+    if (det >= bound || -det >= bound)
+        return det;
+
+    // The expansion of ax by - ay bx + bx cy - by cx + cx ay - cy ax
+    T terms[12]{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    E::two_product(ax, by, terms[1], terms[0]);
+    E::two_product(-ay, bx, terms[3], terms[2]);
+    E::two_product(bx, cy, terms[5], terms[4]);
+    E::two_product(-by, cx, terms[7], terms[6]);
+    E::two_product(cx, ay, terms[9], terms[8]);
+    E::two_product(-cy, ax, terms[11], terms[10]);
+    return E::sum(terms, 12);
+}
+
+/**
+ * @brief Returns the cross product of b - a and d - c with its exact
+ * sign, zero only when the two directions are parallel.
+*/
+template <typename T>
+constexpr T cross2d(T ax, T ay, T bx, T by, T cx, T cy, T dx, T dy) {
+    using E = Exact<T>;
+
+    T left{(bx - ax) * (dy - cy)};
+    T right{(by - ay) * (dx - cx)};
+    T det{left - right};
+
+    // The same form as orient2d, so the same bound holds
+    T sum{(left < 0 ? -left : left) + (right < 0 ? -right : right)};
+    T bound{E::orient2d_bound * sum};
+    if (det > bound || -det > bound)
+        return det;
+
+    // The expansion of (bx - ax) (dy - cy) - (by - ay) (dx - cx)
+    T terms[16]{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    E::two_product(bx, dy, terms[1], terms[0]);
+    E::two_product(-bx, cy, terms[3], terms[2]);
+    E::two_product(-ax, dy, terms[5], terms[4]);
+    E::two_product(ax, cy, terms[7], terms[6]);
+    E::two_product(-by, dx, terms[9], terms[8]);
+    E::two_product(by, cx, terms[11], terms[10]);
+    E::two_product(ay, dx, terms[13], terms[12]);
+    E::two_product(-ay, cx, terms[15], terms[14]);
+    return E::sum(terms, 16);
+}
+};
@@ -0,0 +1,151 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace poly_private {
+namespace simd {
+/**
+ * @brief A vector register of doubles. It uses AVX2 or SSE2 when the
+ * compiler targets them, and a plain double otherwise. The masks
+ * returned by the comparisons have all the bits of a lane set or clear.
+*/
+struct Doubles {
+#if defined(__AVX2__)
+    static const size_t width{4};
+    __m256d v;
+
+    Doubles(__m256d v) : v{v} {}
+    Doubles(double d) : v{_mm256_set1_pd(d)} {}
+
+    static Doubles load(const double *p) { return _mm256_loadu_pd(p); }
+    void store(double *p) const { _mm256_storeu_pd(p, v); }
+
+    friend Doubles operator+(Doubles a, Doubles b) { return _mm256_add_pd(a.v, b.v); }
+    friend Doubles operator-(Doubles a, Doubles b) { return _mm256_sub_pd(a.v, b.v); }
+    friend Doubles operator*(Doubles a, Doubles b) { return _mm256_mul_pd(a.v, b.v); }
+    friend Doubles operator/(Doubles a, Doubles b) { return _mm256_div_pd(a.v, b.v); }
+    friend Doubles operator&(Doubles a, Doubles b) { return _mm256_and_pd(a.v, b.v); }
+    friend Doubles operator|(Doubles a, Doubles b) { return _mm256_or_pd(a.v, b.v); }
+    friend Doubles operator^(Doubles a, Doubles b) { return _mm256_xor_pd(a.v, b.v); }
+    friend Doubles operator<(Doubles a, Doubles b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+    friend Doubles operator>(Doubles a, Doubles b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ); }
+    friend Doubles operator<=(Doubles a, Doubles b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ); }
+
+    /**
+     * @brief Returns b where the mask is set and a elsewhere.
+    */
+    static Doubles select(Doubles mask, Doubles b, Doubles a) { return _mm256_blendv_pd(a.v, b.v, mask.v); }
+
+    /**
+     * @brief Lane-wise minimum. It returns b where a is NaN.
+    */
+    static Doubles min(Doubles a, Doubles b) { return _mm256_min_pd(a.v, b.v); }
+
+    /**
+     * @brief Returns a bit for every lane where the mask is set.
+    */
+    int bits() const { return _mm256_movemask_pd(v); }
+
+    double sum() const {
+        __m128d s{_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1))};
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+
+    double min() const {
+        __m128d s{_mm_min_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1))};
+        return _mm_cvtsd_f64(_mm_min_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    static const size_t width{2};
+    __m128d v;
+
+    Doubles(__m128d v) : v{v} {}
+    Doubles(double d) : v{_mm_set1_pd(d)} {}
+
+    static Doubles load(const double *p) { return _mm_loadu_pd(p); }
+    void store(double *p) const { _mm_storeu_pd(p, v); }
+
+    friend Doubles operator+(Doubles a, Doubles b) { return _mm_add_pd(a.v, b.v); }
+    friend Doubles operator-(Doubles a, Doubles b) { return _mm_sub_pd(a.v, b.v); }
+    friend Doubles operator*(Doubles a, Doubles b) { return _mm_mul_pd(a.v, b.v); }
+    friend Doubles operator/(Doubles a, Doubles b) { return _mm_div_pd(a.v, b.v); }
+    friend Doubles operator&(Doubles a, Doubles b) { return _mm_and_pd(a.v, b.v); }
+    friend Doubles operator|(Doubles a, Doubles b) { return _mm_or_pd(a.v, b.v); }
+    friend Doubles operator^(Doubles a, Doubles b) { return _mm_xor_pd(a.v, b.v); }
+    friend Doubles operator<(Doubles a, Doubles b) { return _mm_cmplt_pd(a.v, b.v); }
+    friend Doubles operator>(Doubles a, Doubles b) { return _mm_cmpgt_pd(a.v, b.v); }
+    friend Doubles operator<=(Doubles a, Doubles b) { return _mm_cmple_pd(a.v, b.v); }
+
+    static Doubles select(Doubles mask, Doubles b, Doubles a) {
+        return _mm_or_pd(_mm_and_pd(mask.v, b.v), _mm_andnot_pd(mask.v, a.v));
+    }
+
+    static Doubles min(Doubles a, Doubles b) { return _mm_min_pd(a.v, b.v); }
+
+    int bits() const { return _mm_movemask_pd(v); }
+
+    double sum() const { return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v))); }
+
+    double min() const { return _mm_cvtsd_f64(_mm_min_sd(v, _mm_unpackhi_pd(v, v))); }
+#else
+    static const size_t width{1};
+    double v;
+
+    Doubles(double d) : v{d} {}
+
+    static Doubles load(const double *p) { return *p; }
+    void store(double *p) const { *p = v; }
+
+    friend Doubles operator+(Doubles a, Doubles b) { return a.v + b.v; }
+    friend Doubles operator-(Doubles a, Doubles b) { return a.v - b.v; }
+    friend Doubles operator*(Doubles a, Doubles b) { return a.v * b.v; }
+    friend Doubles operator/(Doubles a, Doubles b) { return a.v / b.v; }
+    friend Doubles operator&(Doubles a, Doubles b) { return mask(a.bits() & b.bits()); }
+    friend Doubles operator|(Doubles a, Doubles b) { return mask(a.bits() | b.bits()); }
+    friend Doubles operator^(Doubles a, Doubles b) { return mask(a.bits() ^ b.bits()); }
+    friend Doubles operator<(Doubles a, Doubles b) { return mask(a.v < b.v); }
+    friend Doubles operator>(Doubles a, Doubles b) { return mask(a.v > b.v); }
+    friend Doubles operator<=(Doubles a, Doubles b) { return mask(a.v <= b.v); }
+
+    static Doubles select(Doubles mask, Doubles b, Doubles a) { return mask.bits() ? b : a; }
+
+    static Doubles min(Doubles a, Doubles b) { return a.v < b.v ? a : b; }
+
+    // Without vector registers the masks are stored as 0 or -1
+    static Doubles mask(bool set) { return set ? -1.0 : 0.0; }
+    int bits() const { return v != 0 ? 1 : 0; }
+
+    double sum() const { return v; }
+
+    double min() const { return v; }
+#endif
+};
+};
+};
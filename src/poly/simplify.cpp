@@ -0,0 +1,249 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "polygon.hpp"
+#include "edge_grid.hpp"
+#include "split_trace.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <tuple>
+
+using namespace poly_private;
+
+namespace {
+/**
+ * @brief Returns the indices of the vertices that Polygon::simplify
+ * keeps, in increasing order.
+*/
+std::vector<size_t> simplified_vertices(const PolygonView &view, const SimplifyOptions &simplify) {
+    size_t n{view.size()};
+    std::vector<size_t> kept;
+    if (n <= 3) {
+        for (size_t k = 0; k < n; k++) {
+            kept.push_back(k);
+        }
+        return kept;
+    }
+
+    std::vector<size_t> prev(n);
+    std::vector<size_t> next(n);
+    std::vector<double> weights(n);
+    std::vector<bool> removed(n, false);
+    for (size_t k = 0; k < n; k++) {
+        prev[k] = (k + n - 1) % n;
+        next[k] = (k + 1) % n;
+    }
+
+    // Twice the signed area of the triangle of the vertex and its
+    // neighbours. Removing the vertex changes the area by half of it
+    auto cross{[&](size_t k) {
+        Vector a{view[next[k]] - view[prev[k]]};
+        Vector b{view[k] - view[prev[k]]};
+        return a.x * b.y - a.y * b.x;
+    }};
+
+    using Entry = std::tuple<double, size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for (size_t k = 0; k < n; k++) {
+        weights[k] = std::abs(cross(k)) / 2.0;
+        queue.emplace(weights[k], k);
+    }
+
+    double area_error{0};
+    size_t remaining{n};
+    while (!queue.empty() && remaining > 3) {
+        auto [w, k] = queue.top();
+        queue.pop();
+
+        // Stale entries of vertices removed or whose neighbours changed
+        if (removed[k] || w != weights[k])
+            continue;
+
+        size_t p{prev[k]};
+        size_t q{next[k]};
+
+        double error{cross(k) / 2.0};
+        if (std::abs(area_error + error) > simplify.max_area_error)
+            continue;
+
+        Segment edge{view[p], view[q]};
+        bool close{true};
+        for (size_t t = (p + 1) % n; t != q && close; t = (t + 1) % n) {
+            close = view[t].distance(edge.get_nearest_point(view[t])) <= simplify.max_deviation;
+        }
+        if (!close)
+            continue;
+
+        // The vertex is left out of the queue until a neighbour changes
+        removed[k] = true;
+        next[p] = q;
+        prev[q] = p;
+        area_error += error;
+        remaining--;
+
+        for (size_t v : {p, q}) {
+            weights[v] = std::abs(cross(v)) / 2.0;
+            queue.emplace(weights[v], v);
+        }
+    }
+
+    for (size_t k = 0; k < n; k++) {
+        if (!removed[k])
+            kept.push_back(k);
+    }
+    return kept;
+}
+};
+
+Polygon PolygonView::simplify(const SimplifyOptions &simplify) const {
+    Polygon polygon;
+    for (size_t k : simplified_vertices(*this, simplify)) {
+        polygon.vertices.push_back(vertices[k]);
+    }
+    return polygon;
+}
+
+SplitResult PolygonView::split_simplified(double square, const SimplifyOptions &simplify,
+                                          const SplitOptions &options) const {
+    if (vertex_count < 4 || count_square() - square <= POLY_SPLIT_EPS)
+        return try_split(square, options);
+
+    POLY_SPLIT_TRACE_SCOPE("simplify");
+    std::vector<size_t> kept{simplified_vertices(*this, simplify)};
+    size_t m{kept.size()};
+    if (m == vertex_count)
+        return try_split(square, options);
+
+    Points points;
+    points.reserve(m);
+    for (size_t k : kept) {
+        points.push_back(vertices[k]);
+    }
+    const Polygon simple{points};
+
+    size_t n{vertex_count};
+    Points polygon{vertices, vertices + n};
+    bool reversed{!is_clockwise()};
+    if (reversed) {
+        std::reverse(polygon.begin(), polygon.end());
+    }
+
+    POLY_SPLIT_TRACE_NEXT("refine");
+    AreaTable areas{polygon};
+    EdgeGrid edges{polygon};
+    double total{count_square()};
+
+    // The edges of the clockwise copy near the end of a cut on the
+    // simplified edge e. They are looked for in the edges replaced by it
+    // and by its neighbours
+    auto around{[&](size_t e, const Point &end, double radius) {
+        std::vector<int> copy_edges;
+        size_t first{kept[(e + m - 1) % m]};
+        size_t last{kept[(e + 2) % m]};
+        size_t k{first};
+        do {
+            const Segment edge{vertices[k], vertices[(k + 1) % n]};
+            if (edge.get_nearest_point(end).distance(end) <= radius)
+                copy_edges.push_back(static_cast<int>(reversed ? (2 * n - 2 - k) % n : k));
+            k = (k + 1) % n;
+        } while (k != last);
+        return copy_edges;
+    }};
+
+    // The area of the part that split_parts gives to poly2. The closing
+    // edge of its vertices is replaced by the two ends of the cut
+    auto poly2_square{[&](const SplitCandidate &pair) {
+        size_t first{static_cast<size_t>(pair.j + 1) % n};
+        size_t count{n - static_cast<size_t>(pair.j - pair.i)};
+        const Point quad[]{polygon[(first + count - 1) % n], pair.cut.get_end(), pair.cut.get_start(), polygon[first]};
+        return std::abs(areas.count_square_signed(first, count) + PolygonView{quad, 4}.count_square_signed());
+    }};
+
+    // split_pair also finds the cuts that leave the area at the side of
+    // poly1, and split may return them. They are only taken when there
+    // are no others, which may be around the cut of the rest of the area
+    SplitCandidate best;
+    SplitCandidate other;
+    for (double coarse_square : {square, simple.count_square() - square}) {
+        SplitResult coarse{simple.try_split(coarse_square, options)};
+        if (!coarse.exists)
+            continue;
+
+        // The original boundary is within max_deviation of the cut ends,
+        // and the area missing at one side moves the cut about its
+        // quotient by the length of the cut
+        double radius{2 * simplify.max_deviation + POLY_SPLIT_EPS +
+                      simplify.max_area_error / std::max(coarse.cut_line.length(), POLY_SPLIT_EPS)};
+
+        std::vector<std::pair<int, int>> pairs;
+        for (int a : around(coarse.start_edge, coarse.cut_line.get_start(), radius)) {
+            for (int b : around(coarse.end_edge, coarse.cut_line.get_end(), radius)) {
+                if (a != b)
+                    pairs.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        }
+
+        // Searched in the order of split, so the ties are resolved the same way
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+        for (auto [i, j] : pairs) {
+            SplitCandidate pair;
+            std::atomic<double> min_sq_length{best.sq_length};
+            Polygon::split_pair(i, j, polygon, areas, edges, square, min_sq_length, pair);
+            if (!pair.exists)
+                continue;
+
+            double s{poly2_square(pair)};
+            SplitCandidate &side{std::abs(s - square) <= std::abs(s - (total - square)) ? best : other};
+            if (pair.sq_length < side.sq_length)
+                side = pair;
+        }
+
+        if (best.exists)
+            break;
+    }
+
+    if (!best.exists)
+        best = other;
+    if (!best.exists)
+        return try_split(square, options);
+
+    SplitResult result;
+    Polygon::split_parts(polygon, best, result.poly1, result.poly2, result.cut_line);
+    result.status = SplitStatus::Ok;
+    result.exists = true;
+    result.start_edge = reversed ? (2 * n - 2 - best.j) % n : best.j;
+    result.end_edge = reversed ? (2 * n - 2 - best.i) % n : best.i;
+    return result;
+}
+
+Polygon Polygon::simplify(const SimplifyOptions &simplify) const {
+    return view().simplify(simplify);
+}
+
+SplitResult Polygon::split_simplified(double square, const SimplifyOptions &simplify,
+                                      const SplitOptions &options) const {
+    return view().split_simplified(square, simplify, options);
+}
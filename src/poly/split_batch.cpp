@@ -0,0 +1,81 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "split_batch.hpp"
+#include "split_stats.hpp"
+#include "split_workspace.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+void split_batch(const Polygon *polygons, const double *squares, size_t count, SplitResult *results,
+                 const SplitOptions &options) {
+    if (count == 0)
+        return;
+
+    // The time of a split grows with the square of the vertices
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [polygons](size_t a, size_t b) {
+        return polygons[a].size() > polygons[b].size();
+    });
+
+    // One worker for every thread, which takes the polygons one at a time
+    size_t threads{options.pool != nullptr ? options.pool->size() + 1 : 1};
+    threads = std::min(threads, count);
+    std::vector<SplitWorkspace> workspaces(threads);
+    std::vector<SplitStats> stats(threads);
+    std::atomic<size_t> next{0};
+
+    auto work{[&](size_t worker) {
+        const SplitOptions serial{nullptr, options.stats != nullptr ? &stats[worker] : nullptr};
+        for (size_t k = next++; k < count; k = next++) {
+            size_t index{order[k]};
+            polygons[index].try_split(squares[index], results[index], workspaces[worker], serial);
+        }
+    }};
+
+    if (threads > 1) {
+        // Passed by reference, so that std::function does not copy it
+        options.pool->run(threads, std::ref(work));
+    } else {
+        work(0);
+    }
+
+    if (options.stats != nullptr) {
+        for (const SplitStats &counted : stats) {
+            *options.stats += counted;
+        }
+    }
+}
+
+std::vector<SplitResult> split_batch(const std::vector<Polygon> &polygons, const std::vector<double> &squares,
+                                     const SplitOptions &options) {
+    if (polygons.size() != squares.size())
+        throw std::invalid_argument{"There must be one area for every polygon"};
+
+    std::vector<SplitResult> results(polygons.size());
+    split_batch(polygons.data(), squares.data(), polygons.size(), results.data(), options);
+    return results;
+}
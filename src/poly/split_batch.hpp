@@ -0,0 +1,48 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "polygon.hpp"
+
+/**
+ * @brief Splits polygons[k] so that it leaves squares[k], into
+ * results[k], for every k in [0, count). Every polygon is split as
+ * Polygon::try_split does, so the failures are left in the status of
+ * its result instead of thrown.
+ *
+ * The polygons are shared by the workers of options.pool and by the
+ * calling thread, the ones with more vertices first, so the longest
+ * splits do not start last. Each thread takes the next polygon when it
+ * finishes one and keeps its own SplitWorkspace, so the splits do not
+ * allocate once the workspaces have grown. Every split is serial, and
+ * the counts of all of them are added to options.stats.
+*/
+void split_batch(const Polygon *polygons, const double *squares, size_t count, SplitResult *results,
+                 const SplitOptions &options = SplitOptions{});
+
+/**
+ * @brief Same as the other split_batch, returning the results.
+ *
+ * @throws
+ * std::invalid_argument: if there is not one area for every polygon.
+*/
+std::vector<SplitResult> split_batch(const std::vector<Polygon> &polygons, const std::vector<double> &squares,
+                                     const SplitOptions &options = SplitOptions{});
@@ -0,0 +1,144 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "split_cache.hpp"
+
+#include <cstring>
+#include <iterator>
+
+namespace {
+/**
+ * @brief Mixes the bits of a 64 bit value, as the finalizer of
+ * SplitMix64 does.
+*/
+uint64_t mix(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+uint64_t bits(double value) {
+    uint64_t result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+bool same_bits(double a, double b) {
+    return bits(a) == bits(b);
+}
+};
+
+SplitCache::SplitCache(size_t capacity) : max_entries{capacity} {}
+
+uint64_t SplitCache::fingerprint(const Polygon &polygon, double square) {
+    uint64_t result{mix(bits(square) ^ polygon.size())};
+    for (size_t i = 0; i < polygon.size(); i++) {
+        Point p{polygon[i]};
+        result = mix(result ^ bits(p.x));
+        result = mix(result ^ bits(p.y));
+    }
+
+    return result;
+}
+
+bool SplitCache::find(uint64_t key, const Polygon &polygon, double square,
+                      Polygon &poly1, Polygon &poly2, Segment &cut_line) {
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto [first, last] = index.equal_range(key);
+    for (auto it = first; it != last; ++it) {
+        const Entry &entry{*it->second};
+        if (!same_bits(entry.square, square) || entry.vertices.size() != polygon.size())
+            continue;
+
+        bool same{true};
+        for (size_t i = 0; i < polygon.size() && same; i++) {
+            Point p{polygon[i]};
+            same = same_bits(entry.vertices[i].x, p.x) && same_bits(entry.vertices[i].y, p.y);
+        }
+        if (!same)
+            continue;
+
+        hit_count++;
+        entries.splice(entries.begin(), entries, it->second);
+
+        poly1 = entry.poly1;
+        poly2 = entry.poly2;
+        if (entry.failed)
+            throw Polygon::CannotSplitException{entry.message};
+
+        cut_line = entry.cut_line;
+        return true;
+    }
+
+    miss_count++;
+    return false;
+}
+
+void SplitCache::store(uint64_t key, const Polygon &polygon, double square, const Polygon &poly1,
+                       const Polygon &poly2, const Segment &cut_line, const char *failure) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (max_entries == 0)
+        return;
+
+    entries.push_front(Entry{key, polygon.get_vertices(), square, failure != nullptr,
+                             failure != nullptr ? failure : "", poly1, poly2, cut_line});
+    index.emplace(key, entries.begin());
+
+    while (entries.size() > max_entries) {
+        auto [first, last] = index.equal_range(entries.back().fingerprint);
+        for (auto it = first; it != last; ++it) {
+            if (it->second == std::prev(entries.end())) {
+                index.erase(it);
+                break;
+            }
+        }
+        entries.pop_back();
+    }
+}
+
+void SplitCache::split(const Polygon &polygon, double square, Polygon &poly1, Polygon &poly2,
+                       Segment &cut_line, const SplitOptions &options) {
+    split_with(polygon, square, poly1, poly2, cut_line,
+               [&](Polygon &p1, Polygon &p2, Segment &cut) {
+                   polygon.split(square, p1, p2, cut, options);
+               });
+}
+
+size_t SplitCache::hits(void) const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return hit_count;
+}
+
+size_t SplitCache::misses(void) const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return miss_count;
+}
+
+size_t SplitCache::size(void) const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return entries.size();
+}
+
+void SplitCache::clear(void) {
+    std::lock_guard<std::mutex> lock{mutex};
+    entries.clear();
+    index.clear();
+}
@@ -0,0 +1,135 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "polygon.hpp"
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief Remembers the results of the last splits, like the repaints of
+ * an editor or a service that splits the same parcels again. The entries
+ * are found by a fingerprint of the vertices and the area, and then
+ * compared bit by bit. The least recently used entry is dropped when
+ * there are more than the capacity. It can be shared between threads.
+*/
+class SplitCache {
+    private:
+        struct Entry {
+            uint64_t fingerprint;
+            Points vertices;
+            double square;
+            // Whether the split failed, and the message it threw
+            bool failed;
+            std::string message;
+            Polygon poly1;
+            Polygon poly2;
+            Segment cut_line;
+        };
+
+        size_t max_entries;
+        // The most recently used entry goes first
+        std::list<Entry> entries;
+        std::unordered_multimap<uint64_t, std::list<Entry>::iterator> index;
+        size_t hit_count{0};
+        size_t miss_count{0};
+        mutable std::mutex mutex;
+
+        static uint64_t fingerprint(const Polygon &polygon, double square);
+
+        /**
+         * @brief Copies the stored result to the parameters and returns
+         * true if there is one.
+         *
+         * @throws
+         * Polygon::CannotSplitException: if the stored split failed.
+        */
+        bool find(uint64_t key, const Polygon &polygon, double square,
+                  Polygon &poly1, Polygon &poly2, Segment &cut_line);
+
+        void store(uint64_t key, const Polygon &polygon, double square, const Polygon &poly1,
+                   const Polygon &poly2, const Segment &cut_line, const char *failure);
+
+    public:
+        /**
+         * @brief Creates a cache of up to capacity results. A cache without
+         * capacity stores nothing.
+        */
+        explicit SplitCache(size_t capacity = 64);
+        SplitCache(const SplitCache &) = delete;
+        SplitCache &operator=(const SplitCache &) = delete;
+
+        /**
+         * @brief Same as Polygon::split, but it returns the stored result
+         * when the same vertices were split with the same area. The
+         * failures are stored too, and thrown again.
+        */
+        void split(const Polygon &polygon, double square, Polygon &poly1, Polygon &poly2,
+                   Segment &cut_line, const SplitOptions &options = SplitOptions{});
+
+        /**
+         * @brief Same as split, but the misses are solved by
+         * split_function(poly1, poly2, cut_line), which must give the
+         * result of Polygon::split for the polygon and the area.
+        */
+        template <typename Split>
+        void split_with(const Polygon &polygon, double square, Polygon &poly1, Polygon &poly2,
+                        Segment &cut_line, Split &&split_function) {
+            uint64_t key{fingerprint(polygon, square)};
+            if (find(key, polygon, square, poly1, poly2, cut_line))
+                return;
+
+            try {
+                split_function(poly1, poly2, cut_line);
+            } catch (const Polygon::CannotSplitException &e) {
+                store(key, polygon, square, poly1, poly2, cut_line, e.what());
+                throw;
+            }
+
+            store(key, polygon, square, poly1, poly2, cut_line, nullptr);
+        }
+
+        /**
+         * @brief Returns the number of splits answered with a stored result.
+        */
+        size_t hits(void) const;
+
+        /**
+         * @brief Returns the number of splits that had to be computed.
+        */
+        size_t misses(void) const;
+
+        /**
+         * @brief Returns the number of stored results.
+        */
+        size_t size(void) const;
+
+        size_t capacity(void) const {
+            return max_entries;
+        }
+
+        /**
+         * @brief Removes the stored results. The counters are kept.
+        */
+        void clear(void);
+};
@@ -0,0 +1,87 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief What a split did, to find out why some polygons take longer
+ * than others. It is filled when SplitOptions::stats points to it and
+ * the library is built with POLY_SPLIT_STATS. Otherwise the counting is
+ * compiled out and it is left untouched. The counts are added to the
+ * ones it already has, so it can sum several splits.
+*/
+struct SplitStats {
+    // Edge pairs whose cut was looked for
+    uint64_t pairs_visited{0};
+    // Visited pairs where the area does not fit between the edges
+    uint64_t pairs_rejected_by_area{0};
+    // Pairs skipped because their edges are farther apart than the
+    // shortest cut found, with or without visiting them
+    uint64_t pairs_pruned{0};
+    // Decompositions of an edge pair into Polygons
+    uint64_t decompositions{0};
+    // Calls to Polygons::find_cut_line that found a cut
+    uint64_t cuts_found{0};
+    // Cuts checked against the edges of the polygon
+    uint64_t inside_checks{0};
+    // Edges intersected with a cut or with the ray of a point
+    uint64_t intersection_tests{0};
+    // Bytes the search structures grew by. A reused SplitWorkspace
+    // stops growing once it fits the polygons.
+    uint64_t allocated_bytes{0};
+
+    // Copying the vertices and building the search structures
+    double prepare_seconds{0};
+    // Looking for the shortest cut among the edge pairs
+    double search_seconds{0};
+    // Building the parts from the cut
+    double parts_seconds{0};
+
+    SplitStats &operator+=(const SplitStats &stats) {
+        pairs_visited += stats.pairs_visited;
+        pairs_rejected_by_area += stats.pairs_rejected_by_area;
+        pairs_pruned += stats.pairs_pruned;
+        decompositions += stats.decompositions;
+        cuts_found += stats.cuts_found;
+        inside_checks += stats.inside_checks;
+        intersection_tests += stats.intersection_tests;
+        allocated_bytes += stats.allocated_bytes;
+        prepare_seconds += stats.prepare_seconds;
+        search_seconds += stats.search_seconds;
+        parts_seconds += stats.parts_seconds;
+        return *this;
+    }
+};
+
+#ifdef POLY_SPLIT_STATS
+namespace poly_private {
+/**
+ * @brief The counts of the calling thread. The searches of the rows add
+ * them to SplitOptions::stats when they end.
+*/
+extern thread_local SplitStats split_counters;
+};
+
+#define POLY_SPLIT_COUNT(counter, count) (poly_private::split_counters.counter += (count))
+#else
+#define POLY_SPLIT_COUNT(counter, count) ((void)0)
+#endif
@@ -0,0 +1,130 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "split_trace.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+struct Event {
+    const char *name;
+    int64_t start;
+    int64_t end;
+};
+
+/**
+ * @brief The events of a thread. The list of buffers shares them, so
+ * they are kept after the thread ends.
+*/
+struct Buffer {
+    uint32_t thread;
+    std::vector<Event> events;
+};
+
+std::mutex buffers_mutex;
+std::vector<std::shared_ptr<Buffer>> buffers;
+
+#ifdef POLY_SPLIT_TRACE
+std::chrono::steady_clock::time_point origin{std::chrono::steady_clock::now()};
+
+/**
+ * @brief Returns the buffer of the calling thread. The list is only
+ * locked the first time.
+*/
+Buffer &thread_buffer(void) {
+    thread_local std::shared_ptr<Buffer> buffer{[] {
+        std::lock_guard<std::mutex> lock{buffers_mutex};
+        auto created{std::make_shared<Buffer>()};
+        created->thread = static_cast<uint32_t>(buffers.size());
+        buffers.push_back(created);
+        return created;
+    }()};
+
+    return *buffer;
+}
+#endif
+};
+
+#ifdef POLY_SPLIT_TRACE
+std::atomic<bool> poly_private::trace_enabled{false};
+
+int64_t poly_private::trace_now(void) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void poly_private::trace_record(const char *name, int64_t start, int64_t end) {
+    thread_buffer().events.push_back(Event{name, start, end});
+}
+#endif
+
+void SplitTrace::start(void) {
+    std::lock_guard<std::mutex> lock{buffers_mutex};
+    for (const std::shared_ptr<Buffer> &buffer : buffers) {
+        buffer->events.clear();
+    }
+
+#ifdef POLY_SPLIT_TRACE
+    poly_private::trace_enabled.store(true, std::memory_order_relaxed);
+#endif
+}
+
+void SplitTrace::stop(void) {
+#ifdef POLY_SPLIT_TRACE
+    poly_private::trace_enabled.store(false, std::memory_order_relaxed);
+#endif
+}
+
+size_t SplitTrace::size(void) {
+    std::lock_guard<std::mutex> lock{buffers_mutex};
+    size_t count{0};
+    for (const std::shared_ptr<Buffer> &buffer : buffers) {
+        count += buffer->events.size();
+    }
+
+    return count;
+}
+
+void SplitTrace::write(std::ostream &out) {
+    std::lock_guard<std::mutex> lock{buffers_mutex};
+
+    // The times are in microseconds, with the nanoseconds as decimals
+    auto micros{[](int64_t ns) {
+        std::string text{std::to_string(ns / 1000)};
+        std::string decimals{std::to_string(ns % 1000)};
+        return text + "." + std::string(3 - decimals.size(), '0') + decimals;
+    }};
+
+    out << "{\"traceEvents\":[";
+    bool first{true};
+    for (const std::shared_ptr<Buffer> &buffer : buffers) {
+        for (const Event &event : buffer->events) {
+            out << (first ? "\n" : ",\n");
+            out << "{\"name\":\"" << event.name << "\",\"cat\":\"split\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << buffer->thread << ",\"ts\":" << micros(event.start) << ",\"dur\":"
+                << micros(event.end - event.start) << "}";
+            first = false;
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
@@ -0,0 +1,108 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief Records when the phases of the splits start and end, to see
+ * where the time goes on a given polygon. The trace is written in the
+ * JSON format of Chrome and Perfetto, which show it as a timeline with
+ * a track for every thread.
+ *
+ * The events are only recorded when the library is built with
+ * POLY_SPLIT_TRACE, and between start and stop. Every thread writes its
+ * events to its own buffer without locking. start, stop and write must
+ * be called while no split is running.
+*/
+class SplitTrace {
+    public:
+        /**
+         * @brief Removes the recorded events and starts recording.
+        */
+        static void start(void);
+
+        static void stop(void);
+
+        /**
+         * @brief Writes the recorded events as a JSON trace.
+        */
+        static void write(std::ostream &out);
+
+        /**
+         * @brief Returns the number of recorded events.
+        */
+        static size_t size(void);
+};
+
+#ifdef POLY_SPLIT_TRACE
+namespace poly_private {
+extern std::atomic<bool> trace_enabled;
+
+int64_t trace_now(void);
+void trace_record(const char *name, int64_t start, int64_t end);
+
+/**
+ * @brief Records an event from its creation to its destruction, or to
+ * the start of the next one.
+*/
+class TraceScope {
+    private:
+        const char *name;
+        int64_t start{0};
+        bool active;
+
+    public:
+        explicit TraceScope(const char *name) : name{name}, active{trace_enabled.load(std::memory_order_relaxed)} {
+            if (active)
+                start = trace_now();
+        }
+
+        TraceScope(const TraceScope &) = delete;
+        TraceScope &operator=(const TraceScope &) = delete;
+
+        ~TraceScope() {
+            if (active)
+                trace_record(name, start, trace_now());
+        }
+
+        /**
+         * @brief Ends the event and starts another one.
+        */
+        void next(const char *next_name) {
+            if (active) {
+                int64_t now{trace_now()};
+                trace_record(name, start, now);
+                start = now;
+            }
+            name = next_name;
+        }
+};
+};
+
+#define POLY_SPLIT_TRACE_SCOPE(name) poly_private::TraceScope poly_split_trace_scope{name}
+#define POLY_SPLIT_TRACE_NEXT(name) poly_split_trace_scope.next(name)
+#else
+#define POLY_SPLIT_TRACE_SCOPE(name) ((void)0)
+#define POLY_SPLIT_TRACE_NEXT(name) ((void)0)
+#endif
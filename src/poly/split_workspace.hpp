@@ -0,0 +1,57 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "polygon.hpp"
+#include "edge_grid.hpp"
+
+/**
+ * @brief The memory of the search of Polygon::split, kept by the caller
+ * between splits. Once it has grown to the size of the polygons, a
+ * split that passes it and reuses poly1 and poly2 allocates nothing,
+ * unless it fails and throws. A workspace is used by one split at a
+ * time.
+*/
+class SplitWorkspace {
+    private:
+        // The clockwise copy of the vertices and its search structures
+        Points polygon;
+        poly_private::AreaTable areas;
+        poly_private::EdgeBlocks blocks;
+        poly_private::EdgeGrid edges;
+        std::vector<poly_private::SplitCandidate> rows;
+
+        friend class PolygonView;
+        friend class IncrementalSplit;
+
+    public:
+        SplitWorkspace() = default;
+
+        /**
+         * @brief Returns the bytes reserved by the workspace.
+        */
+        size_t memory(void) const {
+            return polygon.capacity() * sizeof(Point) + areas.ring.capacity() * sizeof(Point) +
+                   areas.prefix.capacity() * sizeof(double) +
+                   (blocks.ring.capacity() + blocks.min.capacity() + blocks.max.capacity()) * sizeof(Point) +
+                   edges.memory() + rows.capacity() * sizeof(poly_private::SplitCandidate);
+        }
+};
@@ -0,0 +1,131 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace {
+struct Batch {
+    Batch(size_t count, const std::function<void(size_t)> &task) : count{count}, task{task} {}
+
+    /**
+     * @brief Runs the pending indices of the batch until there are none
+     * left.
+    */
+    void drain() {
+        for (size_t k = next++; k < count; k = next++) {
+            try {
+                task(k);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock{mutex};
+                if (!error)
+                    error = std::current_exception();
+            }
+
+            if (++done == count) {
+                std::lock_guard<std::mutex> lock{mutex};
+                finished.notify_all();
+            }
+        }
+    }
+
+    size_t count;
+    const std::function<void(size_t)> &task;
+
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+};
+}
+
+ThreadPool::ThreadPool(size_t threads) {
+    workers.reserve(threads);
+    for (size_t k = 0; k < threads; k++) {
+        workers.emplace_back([this] { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    available.notify_all();
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+void ThreadPool::work() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            available.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty())
+                return;
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+    }
+}
+
+void ThreadPool::run(size_t count, const std::function<void(size_t)> &task) {
+    if (count == 0)
+        return;
+
+    auto batch{std::make_shared<Batch>(count, task)};
+
+    // The calling thread also drains the batch, so at most count - 1
+    // workers can be useful
+    size_t helpers{std::min(workers.size(), count - 1)};
+    if (helpers > 0) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            for (size_t k = 0; k < helpers; k++) {
+                tasks.emplace_back([batch] { batch->drain(); });
+            }
+        }
+        available.notify_all();
+    }
+
+    batch->drain();
+
+    std::unique_lock<std::mutex> lock{batch->mutex};
+    batch->finished.wait(lock, [&batch] { return batch->done == batch->count; });
+
+    if (batch->error)
+        std::rethrow_exception(batch->error);
+}
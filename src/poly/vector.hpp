@@ -1,6 +1,5 @@
 /**
  * The MIT License (MIT)
- * Copyright (c) 2016 Grabarchuk Viktor
  * Copyright (c) 2023 Pablo López Sedeño
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the “Software”), to deal
@@ -23,36 +22,115 @@
 
 #include "point.hpp"
 
-struct Vector {
-    Point p;
-    double &x = p.x;
-    double &y = p.y;
-
-    Vector(const Point &p);
-    Vector(const Vector &v);
-    Vector(double x=0.0f, double y=0.0f);
-    Vector &operator=(const Vector &v);
-    Vector operator-() const;
-    Vector &operator+=(const Vector &v);
-    Vector &operator-=(const Vector &v);
-    Vector &operator*=(double v);
-    Vector &operator/=(double v);
-    Vector operator-(const Vector &v) const;
-    Vector operator+(const Vector &v) const;
-    Vector operator*(const double v) const;
-    Vector operator/(const double v) const;
-    double dot(const Vector &v) const;
-    double length(void) const;
-    double square_length(void) const;
-    Vector unit(void) const;
-    Vector norm(void) const;
-    bool operator==(const Vector &v) const;
-    bool operator!=(const Vector &v) const;
-    Vector abs() const;
-    friend Point operator+(const Point &p, const Vector &v);
-    friend std::ostream& operator<<(std::ostream &out, const Vector &v);
+template <typename T>
+struct BasicVector {
+    using Traits = ScalarTraits<T>;
+    using Real = typename Traits::Real;
+
+    T x, y;
+
+    constexpr BasicVector(const BasicPoint<T> &p) : x{p.x}, y{p.y} {}
+    constexpr BasicVector(T x = T{}, T y = T{}) : x{x}, y{y} {}
+
+    constexpr BasicVector operator-() const {
+        return BasicVector{-x, -y};
+    }
+
+    constexpr BasicVector &operator+=(const BasicVector &v) {
+        x += v.x;
+        y += v.y;
+
+        return *this;
+    }
+
+    constexpr BasicVector &operator-=(const BasicVector &v) {
+        x -= v.x;
+        y -= v.y;
+
+        return *this;
+    }
+
+    constexpr BasicVector &operator*=(T v) {
+        x *= v;
+        y *= v;
+
+        return *this;
+    }
+
+    constexpr BasicVector &operator/=(T v) {
+        x /= v;
+        y /= v;
+
+        return *this;
+    }
+
+    constexpr BasicVector operator-(const BasicVector &v) const {
+        return BasicVector{x - v.x, y - v.y};
+    }
+
+    constexpr BasicVector operator+(const BasicVector &v) const {
+        return BasicVector{x + v.x, y + v.y};
+    }
+
+    constexpr BasicVector operator*(const T v) const {
+        return BasicVector{x * v, y * v};
+    }
+
+    constexpr BasicVector operator/(const T v) const {
+        return BasicVector{x / v, y / v};
+    }
+
+    constexpr Real dot(const BasicVector &v) const {
+        return static_cast<Real>(x) * v.x + static_cast<Real>(y) * v.y;
+    }
+
+    Real length(void) const {
+        return std::sqrt(square_length());
+    }
+
+    constexpr Real square_length(void) const {
+        return static_cast<Real>(x) * x + static_cast<Real>(y) * y;
+    }
+
+    BasicVector unit(void) const {
+        Real l = length();
+        if (l == 0)
+            return BasicVector{};
+        else
+            return BasicVector{x / l, y / l};
+    }
+
+    constexpr BasicVector norm(void) const {
+        // The length is zero only when its square is
+        if (square_length() == 0)
+            return BasicVector{};
+        else
+            return BasicVector{y, -x};
+    }
+
+    constexpr bool operator==(const BasicVector &v) const {
+        return BasicPoint<T>{x, y} == BasicPoint<T>{v.x, v.y};
+    }
+
+    constexpr bool operator!=(const BasicVector &v) const {
+        return BasicPoint<T>{x, y} != BasicPoint<T>{v.x, v.y};
+    }
+
+    constexpr BasicVector abs() const {
+        return BasicVector{poly_private::abs(x), poly_private::abs(y)};
+    }
+
+    friend constexpr BasicPoint<T> operator+(const BasicPoint<T> &p, const BasicVector &v) {
+        return BasicPoint<T>{p.x + v.x, p.y + v.y};
+    }
+
+    friend std::ostream& operator<<(std::ostream &out, const BasicVector &v) {
+        out << BasicPoint<T>{v.x, v.y};
+        return out;
+    }
 };
 
+using Vector = BasicVector<double>;
 using Vectors = std::vector<Vector>;
 using VecIter = std::vector<Vector>::iterator;
-using CVectIter = std::vector<Vector>::const_iterator;
\ No newline at end of file
+using CVectIter = std::vector<Vector>::const_iterator;
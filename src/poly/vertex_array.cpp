@@ -0,0 +1,238 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include "vertex_array.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using poly_private::simd::Doubles;
+
+namespace {
+// Terms added one after another before they are added pairwise
+const size_t block{256};
+
+// Points classified together against every edge
+const size_t points_block{256};
+
+/**
+ * @brief Adds term(i) for every vertex i in [first, last). The range is
+ * halved until it fits in a block, and the halves are added together.
+*/
+template <typename Term>
+double pairwise_sum(const double *x, const double *y, size_t first, size_t last, const Term &term) {
+    if (last - first > block) {
+        size_t middle{first + (last - first) / 2 / Doubles::width * Doubles::width};
+        return pairwise_sum(x, y, first, middle, term) + pairwise_sum(x, y, middle, last, term);
+    }
+
+    Doubles sum{0.0};
+    size_t i{first};
+    for (; i + Doubles::width <= last; i += Doubles::width) {
+        sum = sum + term(Doubles::load(x + i), Doubles::load(y + i),
+                         Doubles::load(x + i + 1), Doubles::load(y + i + 1));
+    }
+
+    double result{sum.sum()};
+    for (; i < last; i++) {
+        result += term(x[i], y[i], x[i + 1], y[i + 1]);
+    }
+
+    return result;
+}
+}
+
+VertexArray::VertexArray(const Points &points) : count{points.size()} {
+    // One more for the first vertex again, and the zeros up to the width
+    size_t padded{(count + Doubles::width) / Doubles::width * Doubles::width};
+    xs.assign(padded, 0);
+    ys.assign(padded, 0);
+
+    for (size_t i = 0; i < count; i++) {
+        xs[i] = points[i].x;
+        ys[i] = points[i].y;
+    }
+
+    if (count > 0) {
+        xs[count] = points[0].x;
+        ys[count] = points[0].y;
+    }
+}
+
+VertexArray::VertexArray(const Polygon &polygon) : VertexArray(polygon.get_vertices()) {}
+
+size_t VertexArray::size() const {
+    return count;
+}
+
+const double *VertexArray::x() const {
+    return xs.data();
+}
+
+const double *VertexArray::y() const {
+    return ys.data();
+}
+
+double VertexArray::count_square_signed() const {
+    if (count < 3) {
+        return 0;
+    }
+
+    double sum{pairwise_sum(x(), y(), 0, count, [](auto x1, auto y1, auto x2, auto y2) {
+        return x2 * y1 - x1 * y2;
+    })};
+
+    return sum / 2.0;
+}
+
+double VertexArray::count_square() const {
+    return fabs(count_square_signed());
+}
+
+bool VertexArray::is_clockwise() const {
+    if (count < 2)
+        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+
+    double sum{pairwise_sum(x(), y(), 0, count, [](auto x1, auto y1, auto x2, auto y2) {
+        return (x2 - x1) * (y2 + y1);
+    })};
+
+    return sum <= 0;
+}
+
+double VertexArray::find_distance(const Point &point) const {
+    if (count < 2)
+        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+
+    // The arithmetic of Segment::get_nearest_point. The minimum is taken
+    // over the squares, since sqrt keeps their order
+    Doubles px{point.x};
+    Doubles py{point.y};
+    Doubles zero{0.0};
+    Doubles one{1.0};
+    Doubles nearest{std::numeric_limits<double>::infinity()};
+
+    size_t i{0};
+    for (; i + Doubles::width <= count; i += Doubles::width) {
+        Doubles x1{Doubles::load(x() + i)};
+        Doubles y1{Doubles::load(y() + i)};
+        Doubles x2{Doubles::load(x() + i + 1)};
+        Doubles y2{Doubles::load(y() + i + 1)};
+
+        Doubles dx{x2 - x1};
+        Doubles dy{y2 - y1};
+        Doubles u{((px - x1) * dx + (py - y1) * dy) / (dx * dx + dy * dy)};
+
+        Doubles qx{Doubles::select(u < zero, x1, Doubles::select(u > one, x2, x1 + dx * u))};
+        Doubles qy{Doubles::select(u < zero, y1, Doubles::select(u > one, y2, y1 + dy * u))};
+        Doubles ex{qx - px};
+        Doubles ey{qy - py};
+
+        // Degenerate edges give NaN, which Doubles::min skips
+        nearest = Doubles::min(ex * ex + ey * ey, nearest);
+    }
+
+    double result{nearest.min()};
+    for (; i < count; i++) {
+        double d{Segment{Point{xs[i], ys[i]}, Point{xs[i + 1], ys[i + 1]}}.get_nearest_point(point).square_distance(point)};
+        if (d < result)
+            result = d;
+    }
+
+    return sqrt(result);
+}
+
+void VertexArray::classify_points(const Point *points, size_t count, PointLocation *locations) const {
+    if (this->count < 3)
+        throw Polygon::NotEnoughPointsException{"The polygon has not enough vertices"};
+
+    double px[points_block];
+    double py[points_block];
+    double inside[points_block];
+    double boundary[points_block];
+
+    const Doubles zero{0.0};
+    const Doubles sq_eps{POLY_SPLIT_EPS * POLY_SPLIT_EPS};
+
+    for (size_t first = 0; first < count; first += points_block) {
+        size_t m{std::min(points_block, count - first)};
+        size_t padded{(m + Doubles::width - 1) / Doubles::width * Doubles::width};
+        for (size_t k = 0; k < padded; k++) {
+            px[k] = k < m ? points[first + k].x : 0;
+            py[k] = k < m ? points[first + k].y : 0;
+            inside[k] = 0;
+            boundary[k] = 0;
+        }
+
+        for (size_t i = 0; i < this->count; i++) {
+            double dx{xs[i + 1] - xs[i]};
+            double dy{ys[i + 1] - ys[i]};
+            double sq_length{dx * dx + dy * dy};
+            bool upward{ys[i + 1] > ys[i]};
+
+            Doubles x1{xs[i]};
+            Doubles y1{ys[i]};
+            Doubles y2{ys[i + 1]};
+            Doubles edge_x{dx};
+            Doubles edge_y{dy};
+            Doubles edge_sq{sq_length};
+            Doubles limit{sq_length * POLY_SPLIT_EPS * POLY_SPLIT_EPS};
+
+            for (size_t k = 0; k < padded; k += Doubles::width) {
+                Doubles x{Doubles::load(px + k)};
+                Doubles y{Doubles::load(py + k)};
+                Doubles ex{x - x1};
+                Doubles ey{y - y1};
+
+                // Positive when the point is to the left of the edge
+                Doubles cross{edge_x * ey - edge_y * ex};
+
+                // The ray to the right crosses the edges that span the
+                // point, counting their lower end only
+                Doubles spans{(y1 > y) ^ (y2 > y)};
+                Doubles crosses{spans & (upward ? zero < cross : cross < zero)};
+                (Doubles::load(inside + k) ^ crosses).store(inside + k);
+
+                // Near the start vertex, or near the edge between its ends
+                Doubles near{ex * ex + ey * ey <= sq_eps};
+                if (sq_length > 0) {
+                    Doubles dot{edge_x * ex + edge_y * ey};
+                    near = near | ((zero <= dot) & (dot <= edge_sq) & (cross * cross <= limit));
+                }
+                (Doubles::load(boundary + k) | near).store(boundary + k);
+            }
+        }
+
+        for (size_t k = 0; k < m; k += Doubles::width) {
+            int in{Doubles::load(inside + k).bits()};
+            int on{Doubles::load(boundary + k).bits()};
+            for (size_t l = 0; l < Doubles::width && k + l < m; l++) {
+                if (on >> l & 1)
+                    locations[first + k + l] = PointLocation::Boundary;
+                else if (in >> l & 1)
+                    locations[first + k + l] = PointLocation::Inside;
+                else
+                    locations[first + k + l] = PointLocation::Outside;
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * The MIT License (MIT)
+ * Copyright (c) 2023 Pablo López Sedeño
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+
+#include "polygon.hpp"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief The vertices of a polygon stored as separate arrays of x and
+ * y coordinates, so the vector kernels can load several consecutive
+ * vertices at once. The arrays repeat the first vertex after the last
+ * one and are padded with zeros up to a multiple of the vector width.
+ * It is a snapshot: later changes to the polygon are not seen.
+*/
+class VertexArray {
+private:
+    size_t count{0};
+    std::vector<double> xs;
+    std::vector<double> ys;
+
+public:
+    VertexArray() = default;
+    VertexArray(const Points &points);
+    VertexArray(const Polygon &polygon);
+
+    size_t size() const;
+
+    /**
+     * @brief Returns the x coordinates. x()[size()] is the first vertex
+     * again.
+    */
+    const double *x() const;
+
+    /**
+     * @brief Returns the y coordinates. y()[size()] is the first vertex
+     * again.
+    */
+    const double *y() const;
+
+    /**
+     * @brief Returns the polygon area with the sign of
+     * Polygon::count_square_signed. The terms are added pairwise, so the
+     * rounding error grows with the logarithm of the vertices.
+    */
+    double count_square_signed() const;
+    double count_square() const;
+
+    /**
+     * @brief Same as Polygon::is_clockwise.
+     *
+     * @throws
+     * Polygon::NotEnoughPointsException: if there are less than two vertices.
+    */
+    bool is_clockwise() const;
+
+    /**
+     * @brief Same as Polygon::find_distance.
+     *
+     * @throws
+     * Polygon::NotEnoughPointsException: if there are less than two vertices.
+    */
+    double find_distance(const Point &point) const;
+
+    /**
+     * @brief Same as Polygon::classify_points. The points are taken in
+     * blocks, and every edge is tested against a whole block with the
+     * vector kernels.
+     *
+     * @throws
+     * Polygon::NotEnoughPointsException: if there are less than three vertices.
+    */
+    void classify_points(const Point *points, size_t count, PointLocation *locations) const;
+};
@@ -21,9 +21,27 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <type_traits>
 
 #include "../src/poly/polygon.hpp"
+#include "../src/poly/polygon_with_holes.hpp"
+#include "../src/poly/predicates.hpp"
+#include "../src/poly/dataset.hpp"
+#include "../src/poly/edge_grid.hpp"
+#include "../src/poly/incremental_split.hpp"
+#include "../src/poly/split_batch.hpp"
+#include "../src/poly/split_cache.hpp"
+#include "../src/poly/split_stats.hpp"
+#include "../src/poly/split_trace.hpp"
+#include "../src/poly/split_workspace.hpp"
+#include "../src/poly/thread_pool.hpp"
+#include "../src/poly/vertex_array.hpp"
+#include "../src/cli/split_io.hpp"
 
 /* Point Tests */
 TEST(PointTest, DefaultPoint) {
@@ -94,6 +112,32 @@ TEST(PointTest, Absolute) {
     ASSERT_EQ(point.abs(), expected_point);
 }
 
+TEST(PointTest, Constexpr) {
+    static_assert(std::is_trivially_copyable_v<Point>);
+    static_assert(std::is_trivially_copyable_v<Vector>);
+    static_assert(sizeof(Vector) == 2 * sizeof(double));
+
+    constexpr Point point{Point{1, 2} + Vector{3, 4} * 2};
+    static_assert(point == Point{7, 10});
+    static_assert(Point{3, 4}.square_distance(Point{}) == 25);
+
+    ASSERT_EQ(point, Point(7, 10));
+}
+
+TEST(PointTest, ScalarTypes) {
+    static_assert(sizeof(BasicPoint<float>) == 2 * sizeof(float));
+
+    constexpr BasicPoint<int64_t> grid{3, 4};
+    static_assert(grid == BasicPoint<int64_t>{3, 4});
+    static_assert(grid != BasicPoint<int64_t>{3, 5});
+    static_assert(BasicPoint<float>{1, 1} == BasicPoint<float>{1.00001f, 1});
+
+    ASSERT_EQ(grid.distance(BasicPoint<int64_t>{}), 5.0);
+    const BasicPoint<int64_t> rounded{Point(2.6, -2.6)};
+    ASSERT_EQ(rounded, grid - BasicPoint<int64_t>(0, 7));
+    ASSERT_EQ(Point{grid}, Point(3, 4));
+}
+
 /* Vector Tests */
 TEST(VectorTest, DefaultVector) {
     const Vector vec;
@@ -667,6 +711,20 @@ TEST(SegmentTest, Bisector2) {
     ASSERT_EQ(returned.get_distance(expected_end_point), 0);
 }
 
+TEST(SegmentTest, BisectorWithNorms) {
+    const Segment seg1{Point{0, 0}, Point{0, 3}};
+    const Segment seg2{Point{1, 1}, Point{5, 4}};
+
+    ASSERT_EQ(seg1.norm(), 3);
+    ASSERT_EQ(seg2.norm(), 5);
+
+    const Line expected = Segment::get_bisector(seg1, seg2);
+    const Line returned = Segment::get_bisector(seg1, seg1.norm(), seg2, seg2.norm());
+
+    ASSERT_EQ(returned.get_p1(), expected.get_p1());
+    ASSERT_EQ(returned.get_p2(), expected.get_p2());
+}
+
 TEST(SegmentTest, TanAngleZero) {
     const Point start_point;
     const Point end_point{0, 1};
@@ -690,6 +748,104 @@ TEST(SegmentTest, TanAngle1) {
     ASSERT_EQ(Segment::get_tan_angle(seg1, seg2), expected_tan);
 }
 
+TEST(SegmentTest, Constexpr) {
+    static_assert(std::is_trivially_copyable_v<Line>);
+    static_assert(std::is_trivially_copyable_v<Segment>);
+    static_assert(sizeof(Segment) == sizeof(Line));
+
+    constexpr Point cross{[] {
+        Point p;
+        Segment{Point{0, 0}, Point{2, 2}}.cross_line(Segment{Point{0, 2}, Point{2, 0}}, p);
+        return p;
+    }()};
+    static_assert(cross == Point{1, 1});
+
+    ASSERT_EQ(cross, Point(1, 1));
+}
+
+TEST(SegmentTest, Float) {
+    using Segmentf = BasicSegment<float>;
+    using Pointf = BasicPoint<float>;
+
+    const Segmentf seg1{Pointf{0, 0}, Pointf{2, 2}};
+    const Segmentf seg2{Pointf{0, 2}, Pointf{2, 0}};
+    Pointf cross;
+
+    ASSERT_TRUE(seg1.cross_line(seg2, cross));
+    ASSERT_EQ(cross, Pointf(1, 1));
+    ASSERT_FLOAT_EQ(seg1.length(), 2 * sqrtf(2));
+}
+
+/* Predicates Tests */
+TEST(PredicatesTest, Det2) {
+    const double e{std::ldexp(1.0, -52)};
+
+    // (1 + e) (1 - e) rounds to 1
+    ASSERT_LT(poly_private::det2(1 + e, 1.0, 1.0, 1 - e), 0);
+    ASSERT_GT(poly_private::det2(1.0, 1 + e, 1 - e, 1.0), 0);
+    ASSERT_EQ(poly_private::det2(3.0, 6.0, 1.0, 2.0), 0);
+    ASSERT_EQ(poly_private::det2(2.0, 1.0, 1.0, 3.0), 5);
+}
+
+TEST(PredicatesTest, Orient2d) {
+    // Points near the line y = x, like in Kettner et al. "Classroom
+    // examples of robustness problems in geometric computations". Their
+    // coordinates are integers once scaled by 2^53, so the sign can be
+    // computed exactly with 128 bit integers
+    const double ulp{std::ldexp(1.0, -53)};
+    const double bx{12};
+    const double cx{24};
+
+    int wrong{0};
+    for (int i = 0; i < 64; i++) {
+        for (int j = 0; j < 64; j++) {
+            double ax{0.5 + i * ulp};
+            double ay{0.5 + j * ulp};
+
+            auto scaled = [](double v) {
+                return static_cast<__int128>(std::ldexp(v, 53));
+            };
+            __int128 exact{(scaled(ax) - scaled(cx)) * (scaled(bx) - scaled(cx)) -
+                           (scaled(ay) - scaled(cx)) * (scaled(bx) - scaled(cx))};
+            int sign{(exact > 0) - (exact < 0)};
+
+            double orient{poly_private::orient2d(ax, ay, bx, bx, cx, cx)};
+            ASSERT_EQ((orient > 0) - (orient < 0), sign);
+
+            double naive{(ax - cx) * (bx - cx) - (ay - cx) * (bx - cx)};
+            wrong += (naive > 0) - (naive < 0) != sign;
+        }
+    }
+
+    // The inputs are hard enough to fool the plain formula
+    ASSERT_GT(wrong, 0);
+}
+
+TEST(PredicatesTest, PointSide) {
+    const Segment seg{Point{0.5, 0.5}, Point{12, 12}};
+    const double ulp{std::ldexp(1.0, -53)};
+
+    ASSERT_EQ(seg.point_side(Point{24, 24}), PointSide::Inside);
+    ASSERT_EQ(seg.point_side(Point{24, 24 + 8 * ulp * 24}), PointSide::Above);
+    ASSERT_EQ(seg.point_side(Point{24 + 8 * ulp * 24, 24}), PointSide::Below);
+}
+
+TEST(PredicatesTest, CrossNearlyParallel) {
+    // The segments cross near (45353666.84, 18349385.11), but the rounded
+    // coefficients of their lines put the point outside of them
+    const Segment seg1{Point{-57016337.034585215, -23067920.578438174}, Point{57016337.470959663, 23067919.602757271}};
+    const Segment seg2{Point{-57016337.034585193, -23067920.578438185}, Point{57016337.470959648, 23067919.602757268}};
+    Point cross;
+
+    ASSERT_TRUE(seg1.cross_line(seg2, cross));
+    ASSERT_NEAR(cross.x, 45353666.84030332, 1E-6);
+    ASSERT_NEAR(cross.y, 18349385.106964845, 1E-6);
+
+    ASSERT_TRUE(seg2.cross_line(seg1, cross));
+    ASSERT_NEAR(cross.x, 45353666.84030332, 1E-6);
+    ASSERT_NEAR(cross.y, 18349385.106964845, 1E-6);
+}
+
 /* Polygon Tests */
 TEST(PolygonTest, ChangingPoint) {
     Point p1{2, 0};
@@ -776,6 +932,248 @@ TEST(PolygonTest, SplitFalse) {
     ASSERT_THROW(original_poly.split(expected_area, first_poly, second_poly, cut_line), Polygon::CannotSplitException);
 }
 
+TEST(PolygonTest, SplitConcave) {
+    Points original_points;
+    original_points.push_back(Point{});
+    original_points.push_back(Point{6, 0});
+    original_points.push_back(Point{6, 4});
+    original_points.push_back(Point{4, 4});
+    original_points.push_back(Point{4, 1});
+    original_points.push_back(Point{2, 1});
+    original_points.push_back(Point{2, 4});
+    original_points.push_back(Point{0, 4});
+    const Polygon original_poly{original_points};
+    Polygon first_poly;
+    Polygon second_poly;
+    Segment cut_line;
+    const double expected_area{5};
+
+    ASSERT_NO_THROW(original_poly.split(expected_area, first_poly, second_poly, cut_line));
+    ASSERT_NEAR(std::min(first_poly.count_square(), second_poly.count_square()), expected_area, POLY_SPLIT_EPS);
+    ASSERT_NEAR(first_poly.count_square() + second_poly.count_square(), original_poly.count_square(), POLY_SPLIT_EPS);
+    ASSERT_TRUE(original_poly.is_point_inside(cut_line.get_point_along(cut_line.length() / 2)));
+}
+
+TEST(PolygonTest, SplitParallel) {
+    Points original_points;
+    const size_t n{90};
+    for (size_t k = 0; k < n; k++) {
+        double angle{2 * M_PI * k / n};
+        double radius{k % 3 == 0 ? 40.0 : 100.0 + k % 7};
+        original_points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const Polygon original_poly{original_points};
+    const double area{original_poly.count_square() * 0.5};
+
+    Polygon serial_poly1;
+    Polygon serial_poly2;
+    Segment serial_cut;
+    ASSERT_NO_THROW(original_poly.split(area, serial_poly1, serial_poly2, serial_cut));
+
+    ThreadPool pool{4};
+    SplitOptions options;
+    options.pool = &pool;
+
+    Polygon parallel_poly1;
+    Polygon parallel_poly2;
+    Segment parallel_cut;
+    ASSERT_NO_THROW(original_poly.split(area, parallel_poly1, parallel_poly2, parallel_cut, options));
+
+    ASSERT_EQ(parallel_cut.get_start().x, serial_cut.get_start().x);
+    ASSERT_EQ(parallel_cut.get_start().y, serial_cut.get_start().y);
+    ASSERT_EQ(parallel_cut.get_end().x, serial_cut.get_end().x);
+    ASSERT_EQ(parallel_cut.get_end().y, serial_cut.get_end().y);
+    ASSERT_EQ(parallel_poly1.size(), serial_poly1.size());
+    ASSERT_EQ(parallel_poly2.size(), serial_poly2.size());
+}
+
+/**
+ * @brief The search of split without any pruning. Every edge pair of the
+ * clockwise vertices is decomposed, and the first of the shortest cuts
+ * inside the polygon wins.
+*/
+static bool unpruned_split(const Polygon &poly, double square, Segment &best_cut) {
+    Points points{poly.get_vertices()};
+    if (!poly.is_clockwise())
+        std::reverse(points.begin(), points.end());
+    const Polygon clockwise{points};
+    const poly_private::AreaTable areas{points};
+    const size_t n{points.size()};
+
+    bool exists{false};
+    double best_sq_length{DBL_MAX};
+    for (size_t i = 0; i + 1 < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            const Segment s1{points[i], points[i + 1]};
+            const Segment s2{points[j], points[(j + 1) % n]};
+            const double square1{areas.count_square_signed(i + 1, j - i)};
+            const double square2{areas.count_square_signed((j + 1) % n, n - (j - i))};
+            const bool reversed{square + square2 <= 0};
+            const double target{reversed ? square + square1 : square + square2};
+            if (target <= 0)
+                continue;
+
+            poly_private::Polygons polygons{reversed ? s2 : s1, reversed ? s1 : s2};
+            Segment cut;
+            if (!polygons.find_cut_line(target, cut))
+                continue;
+            if (reversed)
+                cut = cut.reverse();
+
+            if (cut.square_length() < best_sq_length && clockwise.is_segment_inside(cut, i, j)) {
+                exists = true;
+                best_sq_length = cut.square_length();
+                best_cut = cut;
+            }
+        }
+    }
+
+    return exists;
+}
+
+/**
+ * @brief Checks that split, serial and on the pool, finds the same cut
+ * as unpruned_split for some areas of the polygon.
+*/
+static void expect_split_unpruned(const Polygon &poly, ThreadPool &pool) {
+    SplitOptions options;
+    options.pool = &pool;
+
+    for (double fraction = 0.05; fraction < 1; fraction += 0.05) {
+        const double square{poly.count_square() * fraction};
+        Segment expected;
+        const bool exists{unpruned_split(poly, square, expected)};
+
+        const SplitResult serial{poly.try_split(square)};
+        ASSERT_EQ(serial.exists, exists);
+        if (exists) {
+            ASSERT_EQ(serial.cut_line, expected);
+        }
+
+        // The pruning of the workers depends on their timing
+        for (size_t run = 0; run < 3; run++) {
+            const SplitResult parallel{poly.try_split(square, options)};
+            ASSERT_EQ(parallel.exists, exists);
+            if (exists) {
+                ASSERT_EQ(parallel.cut_line, expected);
+            }
+        }
+    }
+}
+
+TEST(PolygonTest, SplitSameAsUnpruned) {
+    ThreadPool pool{3};
+
+    // The decomposition of some pairs of this polygon gives cuts off the
+    // ends of the edges, shorter than the distance of the edges
+    const double radii[]{2.03, 7.04, 7.30, 5.77, 4.99, 2.61, 7.48, 9.27, 7.03,
+                         9.32, 5.35, 8.80, 3.98, 9.69, 8.27, 2.40, 2.11, 3.98};
+    Points points;
+    const size_t n{std::size(radii)};
+    for (size_t k = 0; k < n; k++) {
+        double angle{2 * M_PI * k / n};
+        points.push_back(Point{radii[k] * cos(angle), radii[k] * sin(angle)});
+    }
+    expect_split_unpruned(Polygon{points}, pool);
+
+    std::mt19937 random{17};
+    for (size_t polygon = 0; polygon < 40; polygon++) {
+        points.clear();
+        const size_t count{5 + random() % 60};
+        for (size_t k = 0; k < count; k++) {
+            double angle{2 * M_PI * k / count};
+            double radius{2.0 + (random() % 800) / 100.0};
+            points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+        }
+        expect_split_unpruned(Polygon{points}, pool);
+    }
+}
+
+TEST(PolygonTest, SplitFloat) {
+    std::vector<BasicPoint<float>> points;
+    points.push_back(BasicPoint<float>{0, 0});
+    points.push_back(BasicPoint<float>{2, 0});
+    points.push_back(BasicPoint<float>{2, 2});
+    points.push_back(BasicPoint<float>{0, 2});
+    const BasicPolygon<float> poly{points};
+
+    BasicPolygon<float> poly1;
+    BasicPolygon<float> poly2;
+    Segment cut;
+    poly.split(1, poly1, poly2, cut);
+
+    ASSERT_NEAR(std::min(poly1.count_square(), poly2.count_square()), 1, 1e-6);
+    ASSERT_NEAR(poly1.count_square() + poly2.count_square(), 4, 1e-6);
+    ASSERT_TRUE(poly.is_point_inside(BasicPoint<float>{1, 1}));
+    ASSERT_THROW(poly.split(5, poly1, poly2, cut), BasicPolygon<float>::CannotSplitException);
+}
+
+TEST(PolygonTest, SplitInt64) {
+    std::vector<BasicPoint<int64_t>> points;
+    points.push_back(BasicPoint<int64_t>{0, 0});
+    points.push_back(BasicPoint<int64_t>{10, 0});
+    points.push_back(BasicPoint<int64_t>{10, 10});
+    points.push_back(BasicPoint<int64_t>{0, 10});
+    const BasicPolygon<int64_t> poly{points};
+
+    BasicPolygon<int64_t> poly1;
+    BasicPolygon<int64_t> poly2;
+    Segment cut;
+    poly.split(30, poly1, poly2, cut);
+
+    // The cut falls on the grid, so the areas stay exact
+    ASSERT_EQ(std::min(poly1.count_square(), poly2.count_square()), 30);
+    ASSERT_EQ(poly1.count_square() + poly2.count_square(), 100);
+    ASSERT_EQ(poly.find_center(), BasicPoint<int64_t>(5, 5));
+}
+
+TEST(PolygonTest, BasicPolygonChanges) {
+    BasicPolygon<float> poly;
+    poly.push_back(BasicPoint<float>{0, 0});
+    poly.push_back(BasicPoint<float>{2, 0});
+    poly.push_back(BasicPoint<float>{2, 2});
+    ASSERT_FLOAT_EQ(poly.count_square(), 2);
+
+    poly.push_back(BasicPoint<float>{0, 2});
+    ASSERT_FLOAT_EQ(poly.count_square(), 4);
+
+    poly[2].x = 4;
+    ASSERT_FLOAT_EQ(poly.count_square(), 6);
+    ASSERT_TRUE(poly.is_point_inside(BasicPoint<float>{3, 1.5f}));
+
+    poly.split_nearest_edge(BasicPoint<float>{1, -1});
+    ASSERT_EQ(poly.size(), 5u);
+    ASSERT_FLOAT_EQ(poly.count_square(), 6);
+
+    poly.clear();
+    ASSERT_TRUE(poly.empty());
+}
+
+/* Area Table Tests */
+TEST(AreaTableTest, CountSquareSigned) {
+    Points points;
+    points.push_back(Point{1000, 1000});
+    points.push_back(Point{1006, 1000});
+    points.push_back(Point{1006, 1004});
+    points.push_back(Point{1004, 1004});
+    points.push_back(Point{1004, 1001});
+    points.push_back(Point{1002, 1001});
+    points.push_back(Point{1002, 1004});
+    points.push_back(Point{1000, 1004});
+    const poly_private::AreaTable table{points};
+
+    for (size_t first = 0; first < points.size(); first++) {
+        for (size_t count = 1; count < points.size(); count++) {
+            Polygon range;
+            for (size_t k = 0; k < count; k++) {
+                range.push_back(points[(first + k) % points.size()]);
+            }
+
+            ASSERT_NEAR(table.count_square_signed(first, count), range.count_square_signed(), POLY_SPLIT_EPS);
+        }
+    }
+}
+
 TEST(PolygonTest, FindDistanceOutside) {
     Points points;
     points.push_back(Point{});
@@ -982,3 +1380,1376 @@ TEST(PolygonTest, IsClockWiseException) {
 
     ASSERT_THROW(pol.is_clockwise(), Polygon::NotEnoughPointsException);
 }
+
+TEST(PolygonTest, IsConvex) {
+    Points square{Point{0, 0}, Point{0, 2}, Point{1, 2}, Point{2, 2}, Point{2, 0}};
+    ASSERT_TRUE(Polygon{square}.is_convex());
+
+    std::reverse(square.begin(), square.end());
+    ASSERT_TRUE(Polygon{square}.is_convex());
+
+    Points notch{Point{0, 0}, Point{0, 2}, Point{1, 1}, Point{2, 2}, Point{2, 0}};
+    ASSERT_FALSE(Polygon{notch}.is_convex());
+
+    // It turns always the same way, but goes around twice
+    Points pentagram;
+    for (int k = 0; k < 5; k++) {
+        double angle{4.0 * M_PI * k / 5.0};
+        pentagram.push_back(Point{cos(angle), sin(angle)});
+    }
+    ASSERT_FALSE(Polygon{pentagram}.is_convex());
+
+    Points line{Point{0, 0}, Point{1, 1}, Point{2, 2}};
+    ASSERT_FALSE(Polygon{line}.is_convex());
+
+    line.pop_back();
+    ASSERT_FALSE(Polygon{line}.is_convex());
+}
+
+// The pairs of collinear edges give cuts that miss the area, and the
+// shortest cut runs exactly along the whole quadrilateral of two edges
+TEST(PolygonTest, SplitConvexCollinear) {
+    Points points;
+    const int m{10};
+    for (int k = 0; k < m; k++) {
+        points.push_back(Point{0, 4.0 - 4.0 * k / m});
+    }
+    for (int k = 0; k < m; k++) {
+        points.push_back(Point{90.0 * k / m, 0});
+    }
+    for (int k = 0; k < m; k++) {
+        points.push_back(Point{90, 4.0 * k / m});
+    }
+    for (int k = 0; k < m; k++) {
+        points.push_back(Point{90.0 - 90.0 * k / m, 4});
+    }
+    const Polygon poly{points};
+    ASSERT_TRUE(poly.is_convex());
+
+    for (double square : {36.0, 72.0, 180.0, 324.0}) {
+        Polygon poly1;
+        Polygon poly2;
+        Segment cut;
+        ASSERT_NO_THROW(poly.split(square, poly1, poly2, cut));
+        EXPECT_NEAR(poly2.count_square(), square, 1E-9);
+        EXPECT_NEAR(cut.length(), 4.0, 1E-9);
+    }
+}
+
+/* Polygons Tests */
+TEST(PolygonsTest, MinSqLength) {
+    const Segment s1{Point{0, 0}, Point{2, 0}};
+    const Segment s2{Point{3, 3}, Point{5, 4}};
+    const Segment s3{Point{1, -1}, Point{1, 1}};
+
+    ASSERT_NEAR(poly_private::Polygons::min_sq_length(s1, s2), 10, 1E-4);
+    ASSERT_EQ(poly_private::Polygons::min_sq_length(s1, s3), 0);
+}
+
+TEST(PolygonsTest, MaxTotalSquare) {
+    const Segment s1{Point{0, 0}, Point{2, 0}};
+    const Segment s2{Point{2, 2}, Point{0, 2}};
+    poly_private::Polygons polygons{s1, s2};
+
+    ASSERT_GE(poly_private::Polygons::max_total_square(s1, s2), polygons.total_square);
+}
+
+/* Edge Grid Tests */
+TEST(EdgeGridTest, IsPointInside) {
+    Points points;
+    const size_t n{40};
+    for (size_t k = 0; k < n; k++) {
+        double angle{2 * M_PI * k / n};
+        double radius{k % 2 == 0 ? 5.0 : 10.0};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const Polygon poly{points};
+    const poly_private::EdgeGrid grid{points};
+
+    for (double x = -11; x <= 11; x += 0.25) {
+        for (double y = -11; y <= 11; y += 0.25) {
+            const Point point{x, y};
+            ASSERT_EQ(grid.is_point_inside(point), poly.is_point_inside(point));
+        }
+    }
+}
+
+TEST(EdgeGridTest, IsSegmentInside) {
+    Points points;
+    const size_t n{40};
+    for (size_t k = 0; k < n; k++) {
+        double angle{2 * M_PI * k / n};
+        double radius{k % 2 == 0 ? 5.0 : 10.0};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const Polygon poly{points};
+    const poly_private::EdgeGrid grid{points};
+
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            const Segment segment{(points[i] + points[(i + 1) % n]) / 2, (points[j] + points[(j + 1) % n]) / 2};
+            ASSERT_EQ(grid.is_segment_inside(segment, i, j), poly.is_segment_inside(segment, i, j));
+        }
+    }
+}
+
+TEST(EdgeGridTest, LongEdges) {
+    Points points;
+    const size_t n{4096};
+    for (size_t k = 0; k < n; k++) {
+        double angle{2 * M_PI * k / n};
+        double radius{k % 2 == 0 ? 1000.0 : 10.0};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const Polygon poly{points};
+    const poly_private::EdgeGrid grid{points};
+
+    // The edges are only kept in the cells they pass, not in their boxes
+    ASSERT_LT(grid.memory(), 1000 * n);
+
+    for (double x = -1000; x <= 1000; x += 75) {
+        for (double y = -1000; y <= 1000; y += 75) {
+            const Point point{x, y};
+            ASSERT_EQ(grid.is_point_inside(point), poly.is_point_inside(point));
+        }
+    }
+
+    for (size_t i = 0; i < n; i += 97) {
+        size_t j{(i * 7 + 1) % n};
+        const Segment segment{(points[i] + points[(i + 1) % n]) / 2, (points[j] + points[(j + 1) % n]) / 2};
+        ASSERT_EQ(grid.is_segment_inside(segment, i, j), poly.is_segment_inside(segment, i, j));
+    }
+}
+
+TEST(EdgeGridTest, Edges) {
+    Points points;
+    const size_t n{40};
+    for (size_t k = 0; k < n; k++) {
+        double angle{2 * M_PI * k / n};
+        double radius{k % 2 == 0 ? 5.0 : 10.0};
+        points.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+    const poly_private::EdgeGrid grid{points};
+
+    for (size_t i = 0; i < n; i++) {
+        const Segment edge{points[i], points[(i + 1) % n]};
+        ASSERT_EQ(grid.edge(i), edge);
+        ASSERT_EQ(grid.norm(i), edge.norm());
+
+        for (size_t j = i + 1; j < n; j++) {
+            const Segment other{points[j], points[(j + 1) % n]};
+            ASSERT_LE(grid.min_sq_length(i, j), poly_private::Polygons::min_sq_length(edge, other));
+        }
+    }
+}
+
+TEST(EdgeGridTest, NotEnoughPoints) {
+    Points points;
+    points.push_back(Point{});
+    points.push_back(Point{1, 1});
+    const poly_private::EdgeGrid grid{points};
+
+    ASSERT_THROW(grid.is_point_inside(Point{}), Polygon::NotEnoughPointsException);
+}
+
+/* Thread Pool Tests */
+TEST(ThreadPoolTest, Run) {
+    ThreadPool pool{3};
+    std::vector<int> calls(100, 0);
+
+    pool.run(calls.size(), [&calls](size_t k) {
+        calls[k]++;
+    });
+
+    for (int c : calls) {
+        ASSERT_EQ(c, 1);
+    }
+}
+
+TEST(ThreadPoolTest, RunWithoutWorkers) {
+    ThreadPool pool{0};
+    size_t sum{0};
+
+    pool.run(10, [&sum](size_t k) {
+        sum += k;
+    });
+
+    ASSERT_EQ(sum, 45);
+}
+
+TEST(ThreadPoolTest, RunException) {
+    ThreadPool pool{2};
+
+    ASSERT_THROW(pool.run(10, [](size_t k) {
+        if (k == 5)
+            throw std::runtime_error{"error"};
+    }), std::runtime_error);
+}
+
+/* Vertex Array Tests */
+TEST(VertexArrayTest, CountSquareSigned) {
+    // Star with an odd number of vertices, so the kernels run their
+    // scalar tail too
+    Points points;
+    for (int k = 0; k < 1001; k++) {
+        double radius{k % 2 == 0 ? 100.0 : 60.0};
+        points.push_back(Point{radius * cos(2 * M_PI * k / 1001), radius * sin(2 * M_PI * k / 1001)});
+    }
+    const Polygon poly{points};
+    const VertexArray array{poly};
+
+    ASSERT_EQ(array.size(), points.size());
+    ASSERT_NEAR(array.count_square_signed(), poly.count_square_signed(), 1e-9);
+    ASSERT_NEAR(array.count_square(), poly.count_square(), 1e-9);
+    ASSERT_EQ(array.is_clockwise(), poly.is_clockwise());
+
+    std::reverse(points.begin(), points.end());
+    const VertexArray reversed{points};
+
+    ASSERT_NEAR(reversed.count_square_signed(), -poly.count_square_signed(), 1e-9);
+    ASSERT_NE(reversed.is_clockwise(), poly.is_clockwise());
+}
+
+TEST(VertexArrayTest, CountSquareNotEnoughPoints) {
+    Points points;
+    points.push_back(Point{});
+    points.push_back(Point{1, 1});
+    const VertexArray array{points};
+
+    ASSERT_EQ(array.count_square_signed(), 0);
+    ASSERT_THROW(VertexArray{}.is_clockwise(), Polygon::NotEnoughPointsException);
+}
+
+TEST(VertexArrayTest, FindDistance) {
+    Points points;
+    for (int k = 0; k < 37; k++) {
+        double radius{k % 2 == 0 ? 100.0 : 60.0};
+        points.push_back(Point{radius * cos(2 * M_PI * k / 37), radius * sin(2 * M_PI * k / 37)});
+    }
+    // A repeated vertex leaves an edge without length
+    points.insert(points.begin() + 5, points[5]);
+    const Polygon poly{points};
+    const VertexArray array{poly};
+
+    for (double x = -150; x <= 150; x += 25) {
+        for (double y = -150; y <= 150; y += 25) {
+            ASSERT_EQ(array.find_distance(Point{x, y}), poly.find_distance(Point{x, y}));
+        }
+    }
+
+    ASSERT_THROW(VertexArray{}.find_distance(Point{}), Polygon::NotEnoughPointsException);
+}
+
+TEST(PolygonTest, ClassifyPoints) {
+    Points vertices;
+    for (int k = 0; k < 37; k++) {
+        double radius{k % 2 == 0 ? 100.0 : 60.0};
+        vertices.push_back(Point{radius * cos(2 * M_PI * k / 37), radius * sin(2 * M_PI * k / 37)});
+    }
+    const Polygon poly{vertices};
+
+    // An odd number of points, away from the edges
+    Points points;
+    for (double x = -150.5; x <= 150; x += 7) {
+        for (double y = -150.3; y <= 150; y += 7) {
+            points.push_back(Point{x, y});
+        }
+    }
+    points.pop_back();
+
+    std::vector<PointLocation> locations{poly.classify_points(points)};
+    ASSERT_EQ(locations.size(), points.size());
+    for (size_t k = 0; k < points.size(); k++) {
+        PointLocation expected{poly.is_point_inside(points[k]) ? PointLocation::Inside : PointLocation::Outside};
+        ASSERT_EQ(locations[k], expected);
+    }
+}
+
+TEST(PolygonTest, ClassifyPointsBoundary) {
+    Points vertices;
+    vertices.push_back(Point{});
+    vertices.push_back(Point{2, 0});
+    vertices.push_back(Point{2, 2});
+    vertices.push_back(Point{0, 2});
+    const Polygon poly{vertices};
+
+    Points points;
+    points.push_back(Point{2, 2});
+    points.push_back(Point{1, 0});
+    points.push_back(Point{2, 1 + 1e-7});
+    points.push_back(Point{1, 2 + 1e-3});
+    points.push_back(Point{1, 1});
+    std::vector<PointLocation> locations(points.size());
+    poly.classify_points(points.data(), points.size(), locations.data());
+
+    ASSERT_EQ(locations[0], PointLocation::Boundary);
+    ASSERT_EQ(locations[1], PointLocation::Boundary);
+    ASSERT_EQ(locations[2], PointLocation::Boundary);
+    ASSERT_EQ(locations[3], PointLocation::Outside);
+    ASSERT_EQ(locations[4], PointLocation::Inside);
+}
+
+TEST(PolygonTest, ClassifyPointsException) {
+    Points vertices;
+    vertices.push_back(Point{});
+    vertices.push_back(Point{1, 1});
+    const Polygon poly{vertices};
+
+    ASSERT_THROW(poly.classify_points(Points{Point{}}), Polygon::NotEnoughPointsException);
+}
+
+/* Incremental Split Tests */
+static Polygon star_polygon(size_t n) {
+    Polygon poly;
+    for (size_t k = 0; k < n; k++) {
+        double angle{2.0 * M_PI * k / n};
+        double radius{k % 2 == 0 ? 100.0 : 40.0 + 3.0 * (k % 7)};
+        poly.push_back(Point{radius * cos(angle), radius * sin(angle)});
+    }
+
+    return poly;
+}
+
+static void expect_same_split(IncrementalSplit &splitter, const Polygon &poly, double square) {
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+    poly.split(square, poly1, poly2, cut);
+
+    Polygon inc1;
+    Polygon inc2;
+    Segment inc_cut;
+    splitter.split(poly, square, inc1, inc2, inc_cut);
+
+    ASSERT_EQ(inc1.size(), poly1.size());
+    ASSERT_EQ(inc2.size(), poly2.size());
+    ASSERT_NEAR(inc_cut.get_start().distance(cut.get_start()), 0, 1e-6);
+    ASSERT_NEAR(inc_cut.get_end().distance(cut.get_end()), 0, 1e-6);
+}
+
+TEST(IncrementalSplitTest, MoveVertex) {
+    Polygon poly{star_polygon(64)};
+    double square{poly.count_square() / 3.0};
+    IncrementalSplit splitter;
+
+    expect_same_split(splitter, poly, square);
+    for (size_t step = 0; step < 40; step++) {
+        size_t v{(step * 13) % poly.size()};
+        poly[v] = poly[v] * (step % 3 == 0 ? 1.1 : 0.93);
+        expect_same_split(splitter, poly, square);
+
+        // Without changes the previous result is returned
+        expect_same_split(splitter, poly, square);
+    }
+}
+
+TEST(IncrementalSplitTest, MoveSeveralVertices) {
+    Polygon poly{star_polygon(48)};
+    double square{poly.count_square() / 5.0};
+    IncrementalSplit splitter;
+
+    expect_same_split(splitter, poly, square);
+    for (size_t step = 0; step < 10; step++) {
+        for (size_t k = 0; k < 3; k++) {
+            size_t v{(step * 7 + k * 16) % poly.size()};
+            poly[v] = poly[v] + Point{3.0, -2.0};
+        }
+        expect_same_split(splitter, poly, square);
+    }
+}
+
+TEST(IncrementalSplitTest, RandomDrags) {
+    // Drags of spiky polygons whose pruned pairs used to hide a shorter cut
+    for (unsigned seed : {581u, 1592u}) {
+        std::mt19937 random{seed};
+        Polygon poly;
+        const size_t n{10 + random() % 60};
+        for (size_t k = 0; k < n; k++) {
+            double angle{2.0 * M_PI * k / n};
+            double radius{k % 2 == 0 ? 100.0 : 2.0 + random() % 98};
+            poly.push_back(Point{radius * cos(angle), radius * sin(angle)});
+        }
+        const double square{poly.count_square() * (10 + random() % 80) / 100.0};
+        IncrementalSplit splitter;
+
+        size_t v{0};
+        for (size_t step = 0; step < 60; step++) {
+            if (step % 5 == 0)
+                v = random() % n;
+            poly[v] = poly[v] + Point{(random() % 101 - 50.0) / 2.0, (random() % 101 - 50.0) / 2.0};
+
+            const SplitResult expected{poly.try_split(square)};
+            Polygon poly1;
+            Polygon poly2;
+            Segment cut;
+            bool exists{true};
+            try {
+                splitter.split(poly, square, poly1, poly2, cut);
+            } catch (const Polygon::CannotSplitException &) {
+                exists = false;
+            }
+
+            IncrementalSplit fresh;
+            Polygon fresh1;
+            Polygon fresh2;
+            Segment fresh_cut;
+            bool fresh_exists{true};
+            try {
+                fresh.split(poly, square, fresh1, fresh2, fresh_cut);
+            } catch (const Polygon::CannotSplitException &) {
+                fresh_exists = false;
+            }
+
+            ASSERT_EQ(exists, expected.exists);
+            ASSERT_EQ(fresh_exists, expected.exists);
+            if (exists) {
+                ASSERT_NEAR(cut.get_start().distance(expected.cut_line.get_start()), 0, 1e-6);
+                ASSERT_NEAR(cut.get_end().distance(expected.cut_line.get_end()), 0, 1e-6);
+                ASSERT_NEAR(poly2.count_square(), expected.poly2.count_square(), 1e-6);
+                ASSERT_NEAR(cut.get_start().distance(fresh_cut.get_start()), 0, 1e-6);
+                ASSERT_NEAR(cut.get_end().distance(fresh_cut.get_end()), 0, 1e-6);
+            }
+        }
+    }
+}
+
+TEST(IncrementalSplitTest, MovesBelowTolerance) {
+    Points square{Point{0, 0}, Point{10, 0}, Point{10, 10}, Point{0, 10}};
+    IncrementalSplit splitter;
+    Polygon poly{square};
+    double area{poly.count_square() / 3.0};
+
+    // Each step is within POLY_SPLIT_EPS, but they add up
+    for (size_t step = 1; step <= 20000; step++) {
+        poly[2] = Point{10 + step * 0.9e-6, 10 + step * 0.9e-6};
+        if (step % 2000 == 0) {
+            expect_same_split(splitter, poly, area);
+        } else {
+            Polygon poly1;
+            Polygon poly2;
+            Segment cut;
+            splitter.split(poly, area, poly1, poly2, cut);
+        }
+    }
+}
+
+TEST(IncrementalSplitTest, Reset) {
+    Polygon poly{star_polygon(32)};
+    IncrementalSplit splitter;
+
+    expect_same_split(splitter, poly, poly.count_square() / 4.0);
+    expect_same_split(splitter, poly, poly.count_square() / 2.0);
+
+    poly.push_back(Point{150.0, -10.0});
+    expect_same_split(splitter, poly, poly.count_square() / 2.0);
+
+    Points reversed{poly.get_vertices()};
+    std::reverse(reversed.begin(), reversed.end());
+    expect_same_split(splitter, Polygon{reversed}, poly.count_square() / 2.0);
+
+    for (Point &p : reversed) {
+        p = p * 0.5;
+    }
+    expect_same_split(splitter, Polygon{reversed}, poly.count_square() / 10.0);
+}
+
+TEST(IncrementalSplitTest, CannotSplit) {
+    Polygon poly{star_polygon(16)};
+    IncrementalSplit splitter;
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+
+    ASSERT_THROW(splitter.split(poly, poly.count_square(), poly1, poly2, cut), Polygon::CannotSplitException);
+    ASSERT_EQ(poly1.size(), poly.size());
+
+    expect_same_split(splitter, poly, poly.count_square() / 2.0);
+}
+
+/* Split Cache Tests */
+TEST(SplitCacheTest, HitsAndMisses) {
+    const Polygon poly{star_polygon(24)};
+    double square{poly.count_square() / 3.0};
+    SplitCache cache;
+
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+    poly.split(square, poly1, poly2, cut);
+
+    for (int k = 0; k < 3; k++) {
+        Polygon cached1;
+        Polygon cached2;
+        Segment cached_cut;
+        cache.split(poly, square, cached1, cached2, cached_cut);
+
+        ASSERT_EQ(cached1.get_vertices(), poly1.get_vertices());
+        ASSERT_EQ(cached2.get_vertices(), poly2.get_vertices());
+        ASSERT_EQ(cached_cut.get_start(), cut.get_start());
+        ASSERT_EQ(cached_cut.get_end(), cut.get_end());
+    }
+    ASSERT_EQ(cache.misses(), 1);
+    ASSERT_EQ(cache.hits(), 2);
+
+    // Another area or a moved vertex is another entry
+    cache.split(poly, square / 2.0, poly1, poly2, cut);
+    Polygon moved{poly};
+    moved[3] = moved[3] * 1.01;
+    cache.split(moved, square, poly1, poly2, cut);
+
+    ASSERT_EQ(cache.misses(), 3);
+    ASSERT_EQ(cache.hits(), 2);
+    ASSERT_EQ(cache.size(), 3);
+}
+
+TEST(SplitCacheTest, LeastRecentlyUsed) {
+    SplitCache cache{2};
+    const Polygon a{star_polygon(12)};
+    const Polygon b{star_polygon(16)};
+    const Polygon c{star_polygon(20)};
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+    auto split{[&](const Polygon &poly) {
+        cache.split(poly, poly.count_square() / 3.0, poly1, poly2, cut);
+    }};
+
+    split(a);
+    split(b);
+    split(a);
+    split(c);
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(cache.hits(), 1);
+
+    // b was the least recently used one
+    split(a);
+    split(b);
+    ASSERT_EQ(cache.hits(), 2);
+    ASSERT_EQ(cache.misses(), 4);
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+}
+
+TEST(SplitCacheTest, Failure) {
+    const Polygon poly{star_polygon(12)};
+    SplitCache cache;
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+
+    for (int k = 0; k < 2; k++) {
+        poly1.clear();
+        ASSERT_THROW(cache.split(poly, poly.count_square(), poly1, poly2, cut), Polygon::CannotSplitException);
+        ASSERT_EQ(poly1.size(), poly.size());
+    }
+    ASSERT_EQ(cache.misses(), 1);
+    ASSERT_EQ(cache.hits(), 1);
+}
+
+TEST(SplitCacheTest, WithoutCapacity) {
+    const Polygon poly{star_polygon(12)};
+    SplitCache cache{0};
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+    int calls{0};
+
+    for (int k = 0; k < 2; k++) {
+        cache.split_with(poly, 5000, poly1, poly2, cut, [&](Polygon &p1, Polygon &p2, Segment &c) {
+            calls++;
+            poly.split(5000, p1, p2, c);
+        });
+    }
+    ASSERT_EQ(calls, 2);
+    ASSERT_EQ(cache.size(), 0);
+}
+
+/* Split Many Tests */
+static void expect_split_many(const Polygon &poly, const std::vector<double> &squares,
+                              const SplitOptions &options = SplitOptions{}) {
+    std::vector<SplitResult> results{poly.split_many(squares, options)};
+    ASSERT_EQ(results.size(), squares.size());
+
+    for (size_t k = 0; k < squares.size(); k++) {
+        Polygon poly1;
+        Polygon poly2;
+        Segment cut;
+        bool exists{true};
+        try {
+            poly.split(squares[k], poly1, poly2, cut);
+        } catch (const Polygon::CannotSplitException &) {
+            exists = false;
+        }
+
+        ASSERT_EQ(results[k].exists, exists);
+        ASSERT_EQ(results[k].poly1.get_vertices(), poly1.get_vertices());
+        if (exists) {
+            ASSERT_EQ(results[k].poly2.get_vertices(), poly2.get_vertices());
+            ASSERT_EQ(results[k].cut_line.get_start(), cut.get_start());
+            ASSERT_EQ(results[k].cut_line.get_end(), cut.get_end());
+        }
+    }
+}
+
+TEST(SplitManyTest, SameAsSplit) {
+    const Polygon poly{star_polygon(40)};
+    std::vector<double> squares;
+    for (int k = 0; k <= 10; k++) {
+        squares.push_back(poly.count_square() * k / 10.0);
+    }
+
+    expect_split_many(poly, squares);
+
+    Points reversed{poly.get_vertices()};
+    std::reverse(reversed.begin(), reversed.end());
+    expect_split_many(Polygon{reversed}, squares);
+}
+
+// split_many searches every edge pair, while split takes the convex path
+TEST(SplitManyTest, Convex) {
+    Points points;
+    for (int k = 0; k < 90; k++) {
+        double angle{2.0 * M_PI * k / 90.0};
+        points.push_back(Point{300.0 * cos(angle), 100.0 * sin(angle)});
+    }
+    const Polygon poly{points};
+    ASSERT_TRUE(poly.is_convex());
+
+    std::vector<double> squares;
+    for (int k = 0; k <= 20; k++) {
+        squares.push_back(poly.count_square() * k / 20.0);
+    }
+    expect_split_many(poly, squares);
+}
+
+TEST(SplitManyTest, Pool) {
+    const Polygon poly{star_polygon(100)};
+    std::vector<double> squares{poly.count_square() * 0.1, poly.count_square() * 0.25, poly.count_square() * 0.5};
+    ThreadPool pool{4};
+    SplitOptions options;
+    options.pool = &pool;
+
+    expect_split_many(poly, squares, options);
+}
+
+TEST(SplitManyTest, NoAreas) {
+    const Polygon poly{star_polygon(10)};
+
+    ASSERT_TRUE(poly.split_many(std::vector<double>{}).empty());
+}
+
+/* Split IO Tests */
+TEST(SplitIOTest, ParseLines) {
+    SplitJob job;
+    ASSERT_TRUE(parse_split_job("  2.5 0 0 0 2 2 2 2 0 ", job));
+    ASSERT_TRUE(job.error.empty());
+    ASSERT_EQ(job.format, SplitFormat::Lines);
+    ASSERT_EQ(job.square, 2.5);
+    ASSERT_EQ(job.polygon.size(), 4);
+    ASSERT_EQ(job.polygon[2], Point(2, 2));
+
+    ASSERT_FALSE(parse_split_job("", job));
+    ASSERT_FALSE(parse_split_job("   ", job));
+    ASSERT_FALSE(parse_split_job("# 1 0 0 0 2 2 2", job));
+}
+
+TEST(SplitIOTest, ParseWkt) {
+    SplitJob job;
+    ASSERT_TRUE(parse_split_job("1 polygon((0 0, 0 2,2 2 , 2 0, 0 0))", job));
+    ASSERT_TRUE(job.error.empty());
+    ASSERT_EQ(job.format, SplitFormat::Wkt);
+    ASSERT_EQ(job.polygon.size(), 4);
+    ASSERT_EQ(job.polygon[3], Point(2, 0));
+}
+
+TEST(SplitIOTest, ParseErrors) {
+    const char *lines[]{
+        "x 0 0 0 2 2 2",
+        "1 0 0 0 2 2",
+        "1 0 0 0 2",
+        "1 LINESTRING (0 0, 1 1)",
+        "1 POLYGON (0 0, 0 1, 1 1)",
+        "1 POLYGON ((0 0, 0 4, 4 4, 0 0), (1 1, 1 2, 2 2, 1 1))",
+        "1 POLYGON ((0 0, 0 4, 4 4, 0 0)) extra"
+    };
+
+    for (const char *line : lines) {
+        SplitJob job;
+        ASSERT_TRUE(parse_split_job(line, job));
+        ASSERT_FALSE(job.error.empty()) << line;
+    }
+}
+
+TEST(SplitIOTest, FormatResult) {
+    SplitJob job;
+    job.line = 7;
+    ASSERT_TRUE(parse_split_job("1 0 0 0 2 2 2 2 0", job));
+
+    SplitResult result;
+    ASSERT_EQ(format_split_result(job, result, "The required area is too big"), "7 error The required area is too big");
+
+    job.polygon.split(job.square, result.poly1, result.poly2, result.cut_line);
+    result.exists = true;
+    ASSERT_EQ(format_split_result(job, result, ""), "7 ok 0 0.5 2 0.5 | 2 2 0 2 0 0.5 2 0.5 | 0 0 2 0 2 0.5 0 0.5");
+
+    job.format = SplitFormat::Wkt;
+    ASSERT_EQ(format_split_result(job, result, ""),
+              "7 ok LINESTRING (0 0.5, 2 0.5) | POLYGON ((2 2, 0 2, 0 0.5, 2 0.5, 2 2)) | "
+              "POLYGON ((0 0, 2 0, 2 0.5, 0 0.5, 0 0))");
+}
+
+/* Dataset Tests */
+static std::string dataset_path(const char *name) {
+    return testing::TempDir() + name;
+}
+
+TEST(DatasetTest, RoundTrip) {
+    const std::string path{dataset_path("round_trip.polyds")};
+    std::vector<Polygon> polygons{
+        star_polygon(40),
+        Polygon{Points{Point{0, 0}, Point{0, 2}, Point{2, 2}, Point{2, 0}}},
+        Polygon{},
+        star_polygon(7)
+    };
+
+    {
+        DatasetWriter writer{path};
+        for (const Polygon &polygon : polygons) {
+            writer.push_back(polygon);
+        }
+        ASSERT_EQ(writer.size(), polygons.size());
+    }
+
+    Dataset dataset{path};
+    ASSERT_EQ(dataset.size(), polygons.size());
+    ASSERT_EQ(dataset.vertex_count(), 40u + 4 + 7);
+    for (size_t k = 0; k < polygons.size(); k++) {
+        PolygonView view{dataset[k]};
+        ASSERT_EQ(Points(view.begin(), view.end()), polygons[k].get_vertices());
+    }
+}
+
+TEST(DatasetTest, Empty) {
+    const std::string path{dataset_path("empty.polyds")};
+    DatasetWriter writer{path};
+    writer.close();
+
+    Dataset dataset{path};
+    ASSERT_EQ(dataset.size(), 0u);
+    ASSERT_EQ(dataset.vertex_count(), 0u);
+}
+
+TEST(DatasetTest, SplitParts) {
+    const std::string path{dataset_path("split_parts.polyds")};
+    const Polygon poly{star_polygon(30)};
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+    poly.split(poly.count_square() / 3, poly1, poly2, cut);
+
+    DatasetWriter writer{path};
+    writer.push_back(poly1);
+    writer.push_back(poly2);
+    writer.close();
+
+    Dataset dataset{path};
+    ASSERT_EQ(dataset.size(), 2u);
+    ASSERT_EQ(Polygon{dataset[0]}.get_vertices(), poly1.get_vertices());
+    ASSERT_EQ(Polygon{dataset[1]}.get_vertices(), poly2.get_vertices());
+}
+
+TEST(DatasetTest, InvalidFiles) {
+    const std::string path{dataset_path("invalid.polyds")};
+    ASSERT_THROW(Dataset{dataset_path("missing.polyds")}, Dataset::InvalidFileException);
+
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << "1 0 0 0 2 2 2 2 0\n";
+    }
+    ASSERT_THROW(Dataset{path}, Dataset::InvalidFileException);
+
+    {
+        DatasetWriter writer{path};
+        writer.push_back(star_polygon(20));
+    }
+    std::string bytes;
+    {
+        std::ifstream file{path, std::ios::binary};
+        bytes.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    }
+
+    // A truncated file loses the offsets table
+    {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+    ASSERT_THROW(Dataset{path}, Dataset::InvalidFileException);
+
+    // The last offset must be the number of vertices
+    std::string wrong{bytes};
+    wrong[wrong.size() - 8] ^= 1;
+    {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file.write(wrong.data(), static_cast<std::streamsize>(wrong.size()));
+    }
+    ASSERT_THROW(Dataset{path}, Dataset::InvalidFileException);
+}
+
+/* Polygon View Tests */
+TEST(PolygonViewTest, SameAsPolygon) {
+    const Polygon polygons[]{
+        star_polygon(25),
+        Polygon{Points{Point{0, 0}, Point{0, 4}, Point{3, 4}, Point{3, 0}}}
+    };
+
+    for (const Polygon &poly : polygons) {
+        Points vertices{poly.get_vertices()};
+        PolygonView view{vertices.data(), vertices.size()};
+
+        ASSERT_EQ(view.size(), poly.size());
+        ASSERT_EQ(view.count_square_signed(), poly.count_square_signed());
+        ASSERT_EQ(view.is_clockwise(), poly.is_clockwise());
+        ASSERT_EQ(view.is_convex(), poly.is_convex());
+        ASSERT_EQ(view.is_point_inside(Point{1, 1}), poly.is_point_inside(Point{1, 1}));
+        ASSERT_EQ(view.find_distance(Point{10, 10}), poly.find_distance(Point{10, 10}));
+
+        Polygon poly1;
+        Polygon poly2;
+        Segment cut;
+        Polygon expected1;
+        Polygon expected2;
+        Segment expected_cut;
+        view.split(poly.count_square() / 4, poly1, poly2, cut);
+        poly.split(poly.count_square() / 4, expected1, expected2, expected_cut);
+        ASSERT_EQ(poly1.get_vertices(), expected1.get_vertices());
+        ASSERT_EQ(poly2.get_vertices(), expected2.get_vertices());
+        ASSERT_EQ(cut.get_start(), expected_cut.get_start());
+        ASSERT_EQ(cut.get_end(), expected_cut.get_end());
+
+        std::vector<SplitResult> results{view.split_many(std::vector<double>{poly.count_square() / 4})};
+        ASSERT_EQ(results[0].poly2.get_vertices(), poly2.get_vertices());
+    }
+}
+
+TEST(PolygonViewTest, SplitTooBig) {
+    Points vertices{Point{0, 0}, Point{0, 2}, Point{2, 2}, Point{2, 0}};
+    PolygonView view{vertices};
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+
+    ASSERT_THROW(view.split(5, poly1, poly2, cut), Polygon::CannotSplitException);
+    ASSERT_EQ(poly1.get_vertices(), vertices);
+}
+
+/* Split Workspace Tests */
+static Polygon ellipse_polygon(size_t n) {
+    Polygon poly;
+    for (size_t k = 0; k < n; k++) {
+        double angle{2.0 * M_PI * k / n};
+        poly.push_back(Point{300.0 * cos(angle), 100.0 * sin(angle)});
+    }
+
+    return poly;
+}
+
+TEST(SplitWorkspaceTest, SameAsSplit) {
+    SplitWorkspace workspace;
+    const Polygon polygons[]{star_polygon(60), ellipse_polygon(40), star_polygon(9), ellipse_polygon(200)};
+
+    for (const Polygon &poly : polygons) {
+        for (int k = 1; k < 9; k++) {
+            double square{poly.count_square() * k / 10.0};
+            Polygon poly1;
+            Polygon poly2;
+            Segment cut;
+            poly.split(square, poly1, poly2, cut, workspace);
+
+            Polygon expected1;
+            Polygon expected2;
+            Segment expected_cut;
+            poly.split(square, expected1, expected2, expected_cut);
+            ASSERT_EQ(poly1.get_vertices(), expected1.get_vertices());
+            ASSERT_EQ(poly2.get_vertices(), expected2.get_vertices());
+            ASSERT_EQ(cut.get_start(), expected_cut.get_start());
+            ASSERT_EQ(cut.get_end(), expected_cut.get_end());
+        }
+    }
+}
+
+TEST(SplitWorkspaceTest, Failure) {
+    SplitWorkspace workspace;
+    const Polygon poly{star_polygon(20)};
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+
+    ASSERT_THROW(poly.split(poly.count_square() * 2, poly1, poly2, cut, workspace), Polygon::CannotSplitException);
+    ASSERT_EQ(poly1.get_vertices(), poly.get_vertices());
+
+    poly.split(poly.count_square() / 2, poly1, poly2, cut, workspace);
+    ASSERT_NEAR(poly2.count_square(), poly.count_square() / 2, 1E-6);
+}
+
+TEST(SplitWorkspaceTest, NoGrowth) {
+    SplitWorkspace workspace;
+    const Polygon polygons[]{star_polygon(100), ellipse_polygon(80)};
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+
+    // The first round grows the workspace, the next ones reuse it
+    size_t memory{0};
+    for (int round = 0; round < 3; round++) {
+        for (const Polygon &poly : polygons) {
+            for (int k = 1; k < 9; k++) {
+                poly.split(poly.count_square() * k / 10.0, poly1, poly2, cut, workspace);
+                if (round > 0) {
+                    ASSERT_EQ(workspace.memory(), memory);
+                }
+            }
+        }
+        memory = workspace.memory();
+        ASSERT_GT(memory, 0u);
+    }
+}
+
+/* Try Split Tests */
+TEST(TrySplitTest, SameAsSplit) {
+    const Polygon poly{star_polygon(40)};
+    for (int k = 1; k < 9; k++) {
+        double square{poly.count_square() * k / 10.0};
+        SplitResult result{poly.try_split(square)};
+
+        Polygon poly1;
+        Polygon poly2;
+        Segment cut;
+        poly.split(square, poly1, poly2, cut);
+        ASSERT_EQ(result.status, SplitStatus::Ok);
+        ASSERT_TRUE(result.exists);
+        ASSERT_EQ(result.poly1.get_vertices(), poly1.get_vertices());
+        ASSERT_EQ(result.poly2.get_vertices(), poly2.get_vertices());
+        ASSERT_EQ(result.cut_line.get_start(), cut.get_start());
+        ASSERT_EQ(result.cut_line.get_end(), cut.get_end());
+    }
+}
+
+TEST(TrySplitTest, Failures) {
+    const Polygon poly{star_polygon(60)};
+
+    SplitResult too_big{poly.try_split(poly.count_square() * 2)};
+    ASSERT_EQ(too_big.status, SplitStatus::AreaTooBig);
+    ASSERT_FALSE(too_big.exists);
+    ASSERT_EQ(too_big.poly1.get_vertices(), poly.get_vertices());
+
+    // No cut inside the star leaves 90% of it
+    SplitResult no_cut{poly.try_split(poly.count_square() * 0.9)};
+    ASSERT_EQ(no_cut.status, SplitStatus::NoCut);
+    ASSERT_FALSE(no_cut.exists);
+    ASSERT_EQ(no_cut.poly1.size(), poly.size());
+
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+    try {
+        poly.split(poly.count_square() * 0.9, poly1, poly2, cut);
+        FAIL();
+    } catch (const Polygon::CannotSplitException &e) {
+        ASSERT_STREQ(e.what(), split_status_message(SplitStatus::NoCut));
+    }
+
+    const Polygon point{Points{Point{1, 1}}};
+    ASSERT_EQ(point.try_split(0.5).status, SplitStatus::NotEnoughPoints);
+    ASSERT_THROW(point.split(0.5, poly1, poly2, cut), Polygon::NotEnoughPointsException);
+}
+
+TEST(TrySplitTest, Edges) {
+    Points vertices{star_polygon(30).get_vertices()};
+    for (int reversed = 0; reversed < 2; reversed++) {
+        const Polygon poly{vertices};
+        for (int k = 1; k < 9; k++) {
+            SplitResult result{poly.try_split(poly.count_square() * k / 10.0)};
+            ASSERT_TRUE(result.exists);
+
+            const Segment start{poly[result.start_edge], poly[(result.start_edge + 1) % poly.size()]};
+            const Segment end{poly[result.end_edge], poly[(result.end_edge + 1) % poly.size()]};
+            ASSERT_NEAR(start.get_nearest_point(result.cut_line.get_start()).distance(result.cut_line.get_start()), 0, 1E-9);
+            ASSERT_NEAR(end.get_nearest_point(result.cut_line.get_end()).distance(result.cut_line.get_end()), 0, 1E-9);
+        }
+
+        std::reverse(vertices.begin(), vertices.end());
+    }
+}
+
+TEST(TrySplitTest, Workspace) {
+    SplitWorkspace workspace;
+    SplitResult result;
+    const Polygon poly{star_polygon(50)};
+
+    poly.try_split(poly.count_square() / 3, result, workspace);
+    ASSERT_EQ(result.status, SplitStatus::Ok);
+    SplitResult expected{poly.try_split(poly.count_square() / 3)};
+    ASSERT_EQ(result.poly2.get_vertices(), expected.poly2.get_vertices());
+    ASSERT_EQ(result.start_edge, expected.start_edge);
+    ASSERT_EQ(result.end_edge, expected.end_edge);
+
+    poly.try_split(poly.count_square() * 2, result, workspace);
+    ASSERT_EQ(result.status, SplitStatus::AreaTooBig);
+    ASSERT_TRUE(result.poly2.empty());
+}
+
+TEST(TrySplitTest, SplitMany) {
+    const Polygon poly{star_polygon(40)};
+    std::vector<double> squares{poly.count_square() / 4, poly.count_square() * 2};
+    std::vector<SplitResult> results{poly.split_many(squares)};
+
+    SplitResult expected{poly.try_split(squares[0])};
+    ASSERT_EQ(results[0].status, SplitStatus::Ok);
+    ASSERT_EQ(results[0].start_edge, expected.start_edge);
+    ASSERT_EQ(results[0].end_edge, expected.end_edge);
+    ASSERT_EQ(results[1].status, SplitStatus::AreaTooBig);
+}
+
+/* Split Stats Tests */
+TEST(SplitStatsTest, Counts) {
+    const Polygon poly{star_polygon(80)};
+    SplitStats stats;
+    SplitOptions options;
+    options.stats = &stats;
+
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+    poly.split(poly.count_square() / 3, poly1, poly2, cut, options);
+
+    // The counts do not change the result
+    Polygon expected1;
+    Polygon expected2;
+    Segment expected_cut;
+    poly.split(poly.count_square() / 3, expected1, expected2, expected_cut);
+    ASSERT_EQ(poly2.get_vertices(), expected2.get_vertices());
+
+#ifdef POLY_SPLIT_STATS
+    ASSERT_GT(stats.pairs_visited, 0u);
+    ASSERT_GE(stats.pairs_visited, stats.pairs_rejected_by_area + stats.decompositions);
+    ASSERT_GE(stats.decompositions, stats.cuts_found);
+    ASSERT_GT(stats.cuts_found, 0u);
+    ASSERT_GT(stats.inside_checks, 0u);
+    ASSERT_GT(stats.intersection_tests, 0u);
+    ASSERT_GT(stats.allocated_bytes, 0u);
+    ASSERT_GT(stats.search_seconds, 0);
+
+    // The counts are added, and a workspace that has grown does not
+    // allocate again
+    const SplitStats single{stats};
+    SplitWorkspace workspace;
+    poly.split(poly.count_square() / 3, poly1, poly2, cut, workspace, options);
+    poly.split(poly.count_square() / 3, poly1, poly2, cut, workspace, options);
+    ASSERT_EQ(stats.pairs_visited, 3 * single.pairs_visited);
+    ASSERT_EQ(stats.cuts_found, 3 * single.cuts_found);
+    ASSERT_EQ(stats.allocated_bytes, 2 * single.allocated_bytes);
+#else
+    ASSERT_EQ(stats.pairs_visited, 0u);
+    ASSERT_EQ(stats.search_seconds, 0);
+#endif
+}
+
+/* Split Trace Tests */
+TEST(SplitTraceTest, Events) {
+    const Polygon poly{star_polygon(40)};
+    Polygon poly1;
+    Polygon poly2;
+    Segment cut;
+
+    SplitTrace::start();
+    poly.split(poly.count_square() / 3, poly1, poly2, cut);
+    SplitTrace::stop();
+    size_t recorded{SplitTrace::size()};
+
+    // Nothing is recorded once it stops
+    poly.split(poly.count_square() / 3, poly1, poly2, cut);
+    ASSERT_EQ(SplitTrace::size(), recorded);
+
+    std::ostringstream out;
+    SplitTrace::write(out);
+    const std::string json{out.str()};
+    ASSERT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+
+#ifdef POLY_SPLIT_TRACE
+    ASSERT_GT(recorded, 0u);
+    for (const char *name : {"prepare", "search", "pairs", "Polygons", "find_cut_line", "is_segment_inside", "parts"}) {
+        ASSERT_NE(json.find(std::string{"\"name\":\""} + name + "\""), std::string::npos) << name;
+    }
+#else
+    ASSERT_EQ(recorded, 0u);
+#endif
+}
+
+/* Simplify Tests */
+static Polygon noisy_ellipse_polygon(size_t n) {
+    Polygon poly;
+    for (size_t k = 0; k < n; k++) {
+        double angle{2.0 * M_PI * k / n};
+        double noise{1.0 + 0.002 * sin(2.4 * k)};
+        poly.push_back(Point{300.0 * noise * cos(angle), 100.0 * noise * sin(angle)});
+    }
+
+    return poly;
+}
+
+TEST(SimplifyTest, Collinear) {
+    const Polygon poly{Points{{0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}, {1, 2}, {0, 2}, {0, 1}}};
+    const Polygon simple{poly.simplify(SimplifyOptions{})};
+    ASSERT_EQ(simple.get_vertices(), (Points{{0, 0}, {2, 0}, {2, 2}, {0, 2}}));
+
+    // Nothing else is removed without tolerance
+    const Polygon star{star_polygon(20)};
+    ASSERT_EQ(star.simplify(SimplifyOptions{}).get_vertices(), star.get_vertices());
+}
+
+TEST(SimplifyTest, Bounds) {
+    const Polygon poly{noisy_ellipse_polygon(2000)};
+    const SimplifyOptions options{1, 200};
+    const Polygon simple{poly.simplify(options)};
+    ASSERT_LT(simple.size(), poly.size() / 10);
+    ASSERT_GE(simple.size(), 3u);
+
+    for (size_t k = 0; k < poly.size(); k++) {
+        ASSERT_LE(simple.find_distance(poly[k]), options.max_deviation + 1E-9);
+    }
+    ASSERT_LE(std::abs(simple.count_square() - poly.count_square()), options.max_area_error + 1E-6);
+
+    // The bound of the area holds on its own
+    const Polygon tight{poly.simplify(SimplifyOptions{100, 1})};
+    ASSERT_LE(std::abs(tight.count_square() - poly.count_square()), 1 + 1E-6);
+}
+
+TEST(SimplifyTest, SplitSimplified) {
+    const SimplifyOptions options{1, 200};
+    for (int reversed = 0; reversed < 2; reversed++) {
+        Points vertices{noisy_ellipse_polygon(1000).get_vertices()};
+        if (reversed)
+            std::reverse(vertices.begin(), vertices.end());
+        const Polygon poly{vertices};
+
+        for (int k = 1; k < 10; k++) {
+            double square{poly.count_square() * k / 10.0};
+            SplitResult result{poly.split_simplified(square, options)};
+            SplitResult exact{poly.try_split(square)};
+            ASSERT_TRUE(result.exists);
+            ASSERT_EQ(result.status, SplitStatus::Ok);
+
+            // Like split, the area may be left at the side of poly1
+            double square2{result.poly2.count_square()};
+            if (std::abs(square2 - square) > 1E-6 * square)
+                square2 = poly.count_square() - square2;
+            ASSERT_NEAR(square2, square, 1E-6 * square);
+            ASSERT_NEAR(result.poly1.count_square() + result.poly2.count_square(), poly.count_square(), 1E-6 * square);
+
+            // The cut ends lie on the original edges
+            const Segment start{poly[result.start_edge], poly[(result.start_edge + 1) % poly.size()]};
+            const Segment end{poly[result.end_edge], poly[(result.end_edge + 1) % poly.size()]};
+            ASSERT_NEAR(start.get_nearest_point(result.cut_line.get_start()).distance(result.cut_line.get_start()), 0, 1E-9);
+            ASSERT_NEAR(end.get_nearest_point(result.cut_line.get_end()).distance(result.cut_line.get_end()), 0, 1E-9);
+            ASSERT_LE(result.cut_line.length(), exact.cut_line.length() + 2 * options.max_deviation);
+        }
+    }
+}
+
+TEST(SimplifyTest, SplitSimplifiedFailures) {
+    const Polygon poly{noisy_ellipse_polygon(200)};
+    const SimplifyOptions options{1, 200};
+
+    SplitResult result{poly.split_simplified(poly.count_square() + 1, options)};
+    ASSERT_FALSE(result.exists);
+    ASSERT_EQ(result.status, SplitStatus::AreaTooBig);
+    ASSERT_EQ(result.poly1.get_vertices(), poly.get_vertices());
+
+    result = Polygon{}.split_simplified(1, options);
+    ASSERT_EQ(result.status, SplitStatus::NotEnoughPoints);
+
+    // Without anything to remove it is the same as try_split
+    const Polygon star{star_polygon(30)};
+    double square{star.count_square() / 3};
+    result = star.split_simplified(square, SimplifyOptions{});
+    SplitResult expected{star.try_split(square)};
+    ASSERT_EQ(result.poly1.get_vertices(), expected.poly1.get_vertices());
+    ASSERT_EQ(result.poly2.get_vertices(), expected.poly2.get_vertices());
+}
+
+/* Polygon With Holes Tests */
+static Polygon square_ring(double x, double y, double side) {
+    return Polygon{Points{{x, y}, {x + side, y}, {x + side, y + side}, {x, y + side}}};
+}
+
+static void expect_split_parts(const PolygonWithHoles &poly, double square, const PolygonWithHoles &poly1,
+                               const PolygonWithHoles &poly2, const Segment &cut) {
+    // The cut goes around the holes
+    for (int k = 1; k < 100; k++) {
+        ASSERT_TRUE(poly.is_point_inside(cut.get_point_along(cut.length() * k / 100.0)));
+    }
+    ASSERT_NEAR(poly1.count_square() + poly2.count_square(), poly.count_square(), 1E-6);
+    ASSERT_TRUE(std::abs(poly2.count_square() - square) < 1E-6 || std::abs(poly1.count_square() - square) < 1E-6);
+    ASSERT_EQ(poly1.holes().size() + poly2.holes().size(), poly.holes().size());
+
+    // Every hole goes to the part around it
+    for (const PolygonWithHoles *part : {&poly1, &poly2}) {
+        for (const Polygon &hole : part->holes()) {
+            ASSERT_TRUE(part->outer().is_point_inside(hole.find_center()));
+        }
+    }
+}
+
+TEST(PolygonWithHolesTest, AreaAndInside) {
+    const PolygonWithHoles poly{square_ring(0, 0, 10), {square_ring(2, 2, 2), square_ring(6, 6, 3)}};
+    ASSERT_DOUBLE_EQ(poly.count_square(), 100 - 4 - 9);
+    ASSERT_EQ(poly.size(), 12u);
+
+    ASSERT_TRUE(poly.is_point_inside(Point{1, 1}));
+    ASSERT_TRUE(poly.is_point_inside(Point{5, 5}));
+    ASSERT_FALSE(poly.is_point_inside(Point{3, 3}));
+    ASSERT_FALSE(poly.is_point_inside(Point{11, 5}));
+
+    ASSERT_TRUE(poly.is_segment_inside(Segment{Point{1, 1}, Point{1, 9}}, 4, 4));
+    ASSERT_TRUE(poly.is_segment_inside(Segment{Point{1, 0}, Point{1, 10}}, 0, 2));
+    ASSERT_FALSE(poly.is_segment_inside(Segment{Point{1, 3}, Point{5, 3}}, 4, 4));
+    ASSERT_FALSE(poly.is_segment_inside(Segment{Point{2.5, 2.5}, Point{3.5, 3.5}}, 4, 4));
+    ASSERT_FALSE(poly.is_segment_inside(Segment{Point{5, 5}, Point{12, 5}}, 4, 4));
+
+    // Holes without area are left out
+    PolygonWithHoles other{square_ring(0, 0, 10)};
+    other.add_hole(Polygon{Points{{1, 1}, {2, 2}}});
+    ASSERT_TRUE(other.holes().empty());
+}
+
+TEST(PolygonWithHolesTest, SameAsPolygonWithoutHoles) {
+    const Polygon polygons[]{star_polygon(30), ellipse_polygon(40)};
+    for (const Polygon &outer : polygons) {
+        const PolygonWithHoles poly{outer};
+        for (int k = 1; k < 9; k++) {
+            double square{outer.count_square() * k / 10.0};
+            PolygonWithHoles poly1;
+            PolygonWithHoles poly2;
+            Segment cut;
+            poly.split(square, poly1, poly2, cut);
+
+            Polygon expected1;
+            Polygon expected2;
+            Segment expected_cut;
+            outer.split(square, expected1, expected2, expected_cut);
+            ASSERT_EQ(poly1.outer().get_vertices(), expected1.get_vertices());
+            ASSERT_EQ(poly2.outer().get_vertices(), expected2.get_vertices());
+            ASSERT_EQ(cut.get_start(), expected_cut.get_start());
+            ASSERT_EQ(cut.get_end(), expected_cut.get_end());
+        }
+    }
+}
+
+TEST(PolygonWithHolesTest, SplitAroundHoles) {
+    const Polygon outer{Points{{0, 0}, {20, 0}, {20, 10}, {0, 10}}};
+
+    // Away from the cut the hole only changes the area of its part
+    const PolygonWithHoles far{outer, {square_ring(15, 4, 2)}};
+    PolygonWithHoles poly1;
+    PolygonWithHoles poly2;
+    Segment cut;
+    far.split(50, poly1, poly2, cut);
+    expect_split_parts(far, 50, poly1, poly2, cut);
+    ASSERT_NEAR(cut.length(), 10, 1E-9);
+    ASSERT_NEAR(cut.get_start().x, 5, 1E-9);
+
+    // The part keeps the grid of its hole
+    const PolygonWithHoles &right{poly1.holes().empty() ? poly2 : poly1};
+    ASSERT_FALSE(right.is_segment_inside(Segment{Point{14, 5}, Point{18, 5}}, SIZE_MAX, SIZE_MAX));
+    ASSERT_TRUE(right.is_segment_inside(Segment{Point{14, 1}, Point{18, 1}}, SIZE_MAX, SIZE_MAX));
+
+    // The shortest cut of the outer ring would go through the hole
+    const PolygonWithHoles near{outer, {square_ring(4, 4, 2)}};
+    near.split(50, poly1, poly2, cut);
+    expect_split_parts(near, 50, poly1, poly2, cut);
+
+    Polygon outer1;
+    Polygon outer2;
+    Segment outer_cut;
+    outer.split(50, outer1, outer2, outer_cut);
+    ASSERT_FALSE(near.is_segment_inside(outer_cut, 4, 4));
+
+    // With the pool and with several holes
+    ThreadPool pool{2};
+    const PolygonWithHoles several{outer, {square_ring(4, 4, 2), square_ring(9, 1, 1), square_ring(14, 6, 3)}};
+    for (int k = 1; k < 9; k++) {
+        double square{several.count_square() * k / 10.0};
+        several.split(square, poly1, poly2, cut, SplitOptions{&pool});
+        expect_split_parts(several, square, poly1, poly2, cut);
+    }
+}
+
+TEST(PolygonWithHolesTest, SplitFailures) {
+    PolygonWithHoles poly1;
+    PolygonWithHoles poly2;
+    Segment cut;
+    ASSERT_THROW(PolygonWithHoles{}.split(1, poly1, poly2, cut), Polygon::NotEnoughPointsException);
+
+    // The holes are not part of the area
+    const PolygonWithHoles poly{square_ring(0, 0, 10), {square_ring(2, 2, 6)}};
+    ASSERT_THROW(poly.split(80, poly1, poly2, cut), Polygon::CannotSplitException);
+    ASSERT_EQ(poly1.holes().size(), 1u);
+}
+
+/* Split Batch Tests */
+TEST(SplitBatchTest, SameAsTrySplit) {
+    std::vector<Polygon> polygons;
+    std::vector<double> squares;
+    for (size_t k = 0; k < 40; k++) {
+        const Polygon poly{k % 2 == 0 ? star_polygon(6 + k) : ellipse_polygon(4 + 2 * k)};
+        polygons.push_back(poly);
+        squares.push_back(poly.count_square() * (k % 9 + 1) / 10.0);
+    }
+
+    // Failures are reported in their results
+    polygons.push_back(Polygon{});
+    squares.push_back(1);
+    polygons.push_back(star_polygon(12));
+    squares.push_back(polygons.back().count_square() + 1);
+
+    ThreadPool pool{3};
+    for (ThreadPool *with : {static_cast<ThreadPool *>(nullptr), &pool}) {
+        std::vector<SplitResult> results{split_batch(polygons, squares, SplitOptions{with})};
+        ASSERT_EQ(results.size(), polygons.size());
+
+        for (size_t k = 0; k < polygons.size(); k++) {
+            SplitResult expected{polygons[k].try_split(squares[k])};
+            ASSERT_EQ(results[k].status, expected.status) << k;
+            ASSERT_EQ(results[k].exists, expected.exists);
+            ASSERT_EQ(results[k].poly1.get_vertices(), expected.poly1.get_vertices());
+            ASSERT_EQ(results[k].poly2.get_vertices(), expected.poly2.get_vertices());
+            ASSERT_EQ(results[k].cut_line.get_start(), expected.cut_line.get_start());
+            ASSERT_EQ(results[k].cut_line.get_end(), expected.cut_line.get_end());
+        }
+
+        ASSERT_EQ(results[polygons.size() - 2].status, SplitStatus::NotEnoughPoints);
+        ASSERT_EQ(results[polygons.size() - 1].status, SplitStatus::AreaTooBig);
+    }
+}
+
+TEST(SplitBatchTest, Stats) {
+    std::vector<Polygon> polygons{star_polygon(20), star_polygon(30), ellipse_polygon(40)};
+    std::vector<double> squares;
+    SplitStats expected;
+    for (const Polygon &poly : polygons) {
+        squares.push_back(poly.count_square() / 3);
+        poly.try_split(squares.back(), SplitOptions{nullptr, &expected});
+    }
+
+    ThreadPool pool{2};
+    SplitStats stats;
+    split_batch(polygons, squares, SplitOptions{&pool, &stats});
+    ASSERT_EQ(stats.pairs_visited, expected.pairs_visited);
+    ASSERT_EQ(stats.cuts_found, expected.cuts_found);
+}
+
+TEST(SplitBatchTest, Empty) {
+    ASSERT_TRUE(split_batch(std::vector<Polygon>{}, std::vector<double>{}).empty());
+    ASSERT_THROW(split_batch(std::vector<Polygon>{star_polygon(10)}, std::vector<double>{}), std::invalid_argument);
+}